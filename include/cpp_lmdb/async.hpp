@@ -0,0 +1,306 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/db_item.hpp"
+#include "cpp_lmdb/dbs.hpp"
+#include "cpp_lmdb/error.hpp"
+#include "cpp_lmdb/executor.hpp"
+
+// details
+#include "cpp_lmdb/details/key_value_traits.hpp"
+
+// std
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+
+// Awaitable counterparts of the blocking calls. LMDB binds a write
+// transaction (and, without env_flags_t::no_tls, a read-only one) to the
+// thread that began it, so each awaitable runs a complete unit of work on
+// the executor instead of handing a transaction to the awaiting coroutine.
+// The coroutine is resumed on the thread that completed the work.
+namespace lmdb
+{
+namespace details
+{
+template <typename Result, executor_like Executor>
+class async_operation {
+public:
+    async_operation(Executor &executor, std::function<Result()> work)
+        : _executor{executor}, _work{std::move(work)}
+    {}
+
+    auto await_ready() const noexcept -> bool
+    {
+        return false;
+    }
+
+    auto await_suspend(std::coroutine_handle<> const handle) -> void
+    {
+        _executor.get().execute([this, handle] {
+            _result.emplace(_work());
+            handle.resume();
+        });
+    }
+
+    auto await_resume() -> Result
+    {
+        return std::move(*_result);
+    }
+
+private:
+    std::reference_wrapper<Executor> _executor;
+    std::function<Result()> _work;
+    std::optional<Result> _result;
+};
+
+template <typename Item>
+struct async_scan_state {
+    async_scan_state(
+        size_t const buffer_size,
+        std::function<void(std::coroutine_handle<>)> resume_on_executor)
+        : capacity{buffer_size}
+        , resume_consumer{std::move(resume_on_executor)}
+    {}
+
+    // blocks the producer while the buffer is full
+    auto push(Item const &item) -> bool
+    {
+        std::unique_lock lock{mutex};
+        producer_wakeup.wait(
+            lock, [this] { return cancelled || items.size() < capacity; });
+        if (cancelled)
+            return false;
+
+        items.push_back(item);
+        auto const waiting = std::exchange(consumer, nullptr);
+        lock.unlock();
+
+        if (waiting)
+            resume_consumer(waiting);
+        return true;
+    }
+
+    auto complete(std::optional<error_t> const &scan_error) -> void
+    {
+        std::unique_lock lock{mutex};
+        error = scan_error;
+        done = true;
+        auto const waiting = std::exchange(consumer, nullptr);
+        lock.unlock();
+
+        if (waiting)
+            resume_consumer(waiting);
+    }
+
+    // yielded items point into the snapshot, so the producer keeps its
+    // transaction open until the scan is destroyed
+    auto wait_for_cancel() -> void
+    {
+        std::unique_lock lock{mutex};
+        producer_wakeup.wait(lock, [this] { return cancelled; });
+    }
+
+    auto cancel() -> void
+    {
+        {
+            std::lock_guard const lock{mutex};
+            cancelled = true;
+        }
+        producer_wakeup.notify_all();
+    }
+
+    std::mutex mutex;
+    std::condition_variable producer_wakeup;
+    std::deque<Item> items;
+    size_t const capacity;
+    std::function<void(std::coroutine_handle<>)> const resume_consumer;
+    std::coroutine_handle<> consumer;
+    std::optional<error_t> error;
+    bool done{};
+    bool cancelled{};
+};
+}  // namespace details
+
+// Asynchronous scan over a db. A producer thread owned by the scan holds a
+// read-only transaction for the whole scan and fills a bounded buffer, the
+// awaiting coroutine is resumed on the executor. Items stay valid until the
+// scan is destroyed; the db and the executor must outlive the scan.
+template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi>
+class async_scan {
+public:
+    using item_type = ro_db_item<
+        typename KeyValueTrait::key_trait,
+        typename KeyValueTrait::value_trait>;
+
+private:
+    using state_type = details::async_scan_state<item_type>;
+
+public:
+    class next_awaiter {
+    public:
+        explicit next_awaiter(state_type &state) noexcept : _state{state}
+        {}
+
+        auto await_ready() const -> bool
+        {
+            std::lock_guard const lock{_state.mutex};
+            return !_state.items.empty() || _state.done;
+        }
+
+        auto await_suspend(std::coroutine_handle<> const handle) -> bool
+        {
+            std::lock_guard const lock{_state.mutex};
+            if (!_state.items.empty() || _state.done)
+                return false;
+
+            _state.consumer = handle;
+            return true;
+        }
+
+        auto await_resume() -> std::optional<item_type>
+        {
+            std::unique_lock lock{_state.mutex};
+            if (_state.items.empty())
+                return std::nullopt;
+
+            auto item = _state.items.front();
+            _state.items.pop_front();
+            lock.unlock();
+
+            _state.producer_wakeup.notify_all();
+            return item;
+        }
+
+    private:
+        state_type &_state;
+    };
+
+    template <executor_like Executor>
+    async_scan(
+        ro_db<KeyValueTrait, LmdbApi> const &db,
+        Executor &executor,
+        size_t const buffer_size)
+        : _state{std::make_shared<state_type>(
+              buffer_size,
+              [&executor](std::coroutine_handle<> const handle) {
+                  executor.execute([handle] { handle.resume(); });
+              })}
+        , _producer{[&db, state = _state] { produce(db, *state); }}
+    {}
+
+    async_scan(async_scan &&) noexcept = default;
+    async_scan(async_scan const &) = delete;
+    auto operator=(async_scan const &) -> async_scan & = delete;
+
+    // the producer is joined once it ended its transaction
+    ~async_scan()
+    {
+        if (_state)
+            _state->cancel();
+    }
+
+    // resolves to the next item or to std::nullopt at the end of the scan
+    auto next() -> next_awaiter
+    {
+        return next_awaiter{*_state};
+    }
+
+    // error that ended the scan prematurely
+    auto error() const -> std::optional<error_t>
+    {
+        std::lock_guard const lock{_state->mutex};
+        return _state->error;
+    }
+
+private:
+    static auto produce(
+        ro_db<KeyValueTrait, LmdbApi> const &db, state_type &state) -> void
+    {
+        auto txn = db.begin_ro_transaction();
+        if (!txn) {
+            state.complete(txn.error());
+        } else if (auto view = txn->iterate(); !view) {
+            state.complete(view.error());
+        } else {
+            auto it = view->begin();
+            while (it != view->end() && state.push(*it))
+                ++it;
+
+            auto const error = it.error();
+            state.complete(error != error_t::not_found ? error : std::nullopt);
+            state.wait_for_cancel();
+        }
+    }
+
+    std::shared_ptr<state_type> _state;
+    // declared last to be joined before the state is released
+    std::jthread _producer;
+};
+
+template <
+    key_value_trait KeyValueTrait,
+    lmdb_api_like LmdbApi,
+    executor_like Executor = thread_pool_executor>
+auto async_get(
+    ro_db<KeyValueTrait, LmdbApi> const &db,
+    typename KeyValueTrait::key_trait::value_type key,
+    Executor &executor = default_executor())
+    -> details::async_operation<
+        std::expected<
+            typename KeyValueTrait::value_trait::value_type,
+            error_t>,
+        Executor>
+    requires(
+        !details::key_value_trait_helper<KeyValueTrait>::duplicates_enabled)
+{
+    using result_type = std::
+        expected<typename KeyValueTrait::value_trait::value_type, error_t>;
+
+    return {executor, [&db, key = std::move(key)]() -> result_type {
+                auto txn = db.begin_ro_transaction();
+                if (!txn)
+                    return std::unexpected{txn.error()};
+
+                return txn->get(key);
+            }};
+}
+
+// Runs rw_db::write on the executor, see rw_db::write for the semantics.
+template <
+    key_value_trait KeyValueTrait,
+    lmdb_api_like LmdbApi,
+    typename Fn,
+    executor_like Executor = thread_pool_executor>
+auto async_write(
+    rw_db<KeyValueTrait, LmdbApi> &db,
+    Fn fn,
+    Executor &executor = default_executor())
+    -> details::async_operation<std::expected<void, error_t>, Executor>
+{
+    return {executor, [&db, fn = std::move(fn)]() mutable {
+                return db.write(fn);
+            }};
+}
+
+template <
+    key_value_trait KeyValueTrait,
+    lmdb_api_like LmdbApi,
+    executor_like Executor = thread_pool_executor>
+auto async_iterate(
+    ro_db<KeyValueTrait, LmdbApi> const &db,
+    Executor &executor = default_executor(),
+    size_t const buffer_size = 64) -> async_scan<KeyValueTrait, LmdbApi>
+{
+    return async_scan<KeyValueTrait, LmdbApi>{db, executor, buffer_size};
+}
+
+}  // namespace lmdb
@@ -0,0 +1,530 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/dbs.hpp"
+#include "cpp_lmdb/error.hpp"
+
+// details
+#include "cpp_lmdb/details/key_value_traits.hpp"
+#include "cpp_lmdb/details/lz_codec.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace lmdb
+{
+
+struct compression_stats_t {
+    // values serialized by the trait
+    size_t values{};
+    // values stored compressed, the others were too small or incompressible
+    size_t compressed_values{};
+    // bytes before compression and bytes stored, headers included
+    size_t input_bytes{};
+    size_t stored_bytes{};
+
+    auto ratio() const noexcept -> double
+    {
+        if (stored_bytes == 0)
+            return 1.0;
+        return static_cast<double>(input_bytes)
+               / static_cast<double>(stored_bytes);
+    }
+};
+
+namespace details
+{
+// FNV-1a hash identifying a dictionary in the values compressed with it
+inline auto dictionary_id(std::span<std::byte const> const bytes) noexcept
+    -> uint32_t
+{
+    uint32_t hash{2166136261U};
+    for (auto const byte : bytes) {
+        hash ^= std::to_integer<uint32_t>(byte);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+}  // namespace details
+
+// Dictionary of compressed values which do not use one.
+struct no_dictionary {
+    static auto bytes() noexcept -> std::span<std::byte const>
+    {
+        return {};
+    }
+};
+
+// Dictionary trained from the values of a db, see train_dictionary. Each
+// db gets its own tag, e.g. trained_dictionary<struct orders_tag>. The
+// dictionary is installed once, before other threads use the db, and is
+// prepared for Codec at installation when Codec supports it.
+template <typename Tag, compression_codec Codec = lz_codec>
+class trained_dictionary {
+public:
+    using codec_type = Codec;
+
+    static auto bytes() noexcept -> std::span<std::byte const>
+    {
+        return _bytes;
+    }
+
+    static auto id() noexcept -> uint32_t
+    {
+        return _id;
+    }
+
+    static auto prepared() noexcept -> auto const &
+        requires preparing_codec<Codec>
+    {
+        return _prepared<Codec>;
+    }
+
+    static auto install(std::vector<std::byte> bytes) -> void
+    {
+        _bytes = std::move(bytes);
+        _id = details::dictionary_id(_bytes);
+        if constexpr (preparing_codec<Codec>)
+            _prepared<Codec> = Codec::prepare(_bytes);
+    }
+
+private:
+    inline static std::vector<std::byte> _bytes;
+    inline static uint32_t _id{details::dictionary_id({})};
+    template <preparing_codec C>
+    inline static typename C::prepared_dictionary _prepared{};
+};
+
+struct dictionary_options_t {
+    // values sampled from the db
+    size_t sample_count{1024};
+    // bytes, the codec only reaches the last 64 KiB of a dictionary
+    size_t max_size{16 * 1024};
+    // dictionaries are made of the sampled segments of this size shared by
+    // the most samples
+    size_t segment_size{32};
+};
+
+namespace details
+{
+enum class compression_header : uint8_t {
+    raw = 0,
+    compressed = 1,
+    compressed_with_dictionary = 2,
+};
+
+inline auto write_varint(size_t value, std::vector<std::byte> &bytes) -> void
+{
+    for (; value >= 0x80; value >>= 7U)
+        bytes.push_back(static_cast<std::byte>(value | 0x80U));
+    bytes.push_back(static_cast<std::byte>(value));
+}
+
+inline auto read_varint(std::span<std::byte const> &bytes)
+    -> std::optional<size_t>
+{
+    size_t value{};
+    for (unsigned shift = 0; !bytes.empty() && shift < 64; shift += 7) {
+        auto const byte = std::to_integer<size_t>(bytes.front());
+        bytes = bytes.subspan(1);
+        value |= (byte & 0x7FU) << shift;
+        if ((byte & 0x80U) == 0)
+            return value;
+    }
+    return std::nullopt;
+}
+
+// Picks the segments of the samples whose 8-byte substrings occur in the
+// most samples, the most valuable last so that they are the closest to
+// the compressed data.
+inline auto build_dictionary(
+    std::vector<std::vector<std::byte>> const &samples,
+    dictionary_options_t const &options) -> std::vector<std::byte>
+{
+    constexpr size_t gram_size{8};
+    auto const segment_size = std::max(options.segment_size, gram_size);
+
+    auto const gram = [](std::vector<std::byte> const &sample, size_t at) {
+        std::string_view const bytes{
+            reinterpret_cast<char const *>(sample.data() + at), gram_size};
+        return std::hash<std::string_view>{}(bytes);
+    };
+
+    // number of samples each gram occurs in
+    std::unordered_map<size_t, std::pair<size_t, size_t>> grams;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        auto const &sample = samples[i];
+        for (size_t at = 0; at + gram_size <= sample.size(); ++at) {
+            auto &[count, last_sample] = grams[gram(sample, at)];
+            if (count == 0 || last_sample != i) {
+                ++count;
+                last_sample = i;
+            }
+        }
+    }
+
+    struct segment {
+        size_t score;
+        std::span<std::byte const> bytes;
+    };
+    std::vector<segment> segments;
+    for (auto const &sample : samples) {
+        for (size_t at = 0; at + gram_size <= sample.size();
+             at += segment_size) {
+            auto const size = std::min(segment_size, sample.size() - at);
+            size_t score{};
+            for (size_t i = 0; i + gram_size <= size; ++i)
+                score += grams[gram(sample, at + i)].first - 1;
+            if (score > 0)
+                segments.push_back({score, {sample.data() + at, size}});
+        }
+    }
+    std::ranges::stable_sort(
+        segments, std::ranges::greater{}, &segment::score);
+
+    std::vector<std::span<std::byte const>> picked;
+    std::unordered_set<std::string_view> seen;
+    size_t size{};
+    for (auto const &[score, bytes] : segments) {
+        if (size + bytes.size() > options.max_size)
+            continue;
+        std::string_view const key{
+            reinterpret_cast<char const *>(bytes.data()), bytes.size()};
+        if (!seen.insert(key).second)
+            continue;
+        picked.push_back(bytes);
+        size += bytes.size();
+    }
+
+    std::vector<std::byte> dictionary;
+    dictionary.reserve(size);
+    for (auto const &bytes : picked | std::views::reverse)
+        dictionary.insert(dictionary.end(), bytes.begin(), bytes.end());
+    return dictionary;
+}
+
+inline auto write_dictionary_id(uint32_t id, std::vector<std::byte> &bytes)
+    -> void
+{
+    for (size_t i = 0; i < sizeof(id); ++i, id >>= 8U)
+        bytes.push_back(static_cast<std::byte>(id & 0xFFU));
+}
+
+inline auto read_dictionary_id(std::span<std::byte const> &bytes)
+    -> std::optional<uint32_t>
+{
+    if (bytes.size() < sizeof(uint32_t))
+        return std::nullopt;
+
+    uint32_t id{};
+    for (size_t i = 0; i < sizeof(id); ++i)
+        id |= std::to_integer<uint32_t>(bytes[i]) << (8U * i);
+    bytes = bytes.subspan(sizeof(id));
+    return id;
+}
+
+// dictionaries without an id are hashed on use
+template <typename Dictionary>
+auto get_dictionary_id() noexcept -> uint32_t
+{
+    if constexpr (requires { Dictionary::id(); })
+        return Dictionary::id();
+    else
+        return dictionary_id(Dictionary::bytes());
+}
+
+template <typename Dictionary, typename Codec>
+inline constexpr bool has_prepared_dictionary_v = requires {
+    requires std::same_as<typename Dictionary::codec_type, Codec>;
+    Dictionary::prepared();
+};
+
+template <typename T>
+inline constexpr bool is_trained_dictionary_v = requires {
+    T::install(std::declval<std::vector<std::byte>>());
+};
+}  // namespace details
+
+// Side db of trained dictionaries, keyed by the name they were trained
+// under.
+using dictionary_db_trait = unique_key<string_trait, byte_vector_trait>;
+
+// Value trait compressing the bytes of ValueTrait with Codec. Values of at
+// least MinSize bytes are stored behind a one-byte header, the id of the
+// dictionary they were compressed with, if any, and the varint of their
+// uncompressed size; smaller values, and values which do not shrink, are
+// stored as they are behind the header. Values are decompressed into a
+// thread-local buffer before being decoded by ValueTrait, views of them
+// (get_view, iterate_views) return the stored bytes. A stored value which
+// cannot be decompressed fails get and get_many with corrupted, or with
+// incompatible when its dictionary is not the installed one; decoding it
+// elsewhere, e.g. through the items of an iteration, throws
+// std::runtime_error. The order of compressed values is not the order of
+// ValueTrait, so the order flags of ValueTrait are not kept.
+template <
+    value_trait ValueTrait,
+    compression_codec Codec = lz_codec,
+    typename Dictionary = no_dictionary,
+    size_t MinSize = 64>
+    requires deserialization_trait<ValueTrait>
+struct compressed {
+    using value_type = typename ValueTrait::value_type;
+    using inner_trait = ValueTrait;
+    using dictionary_type = Dictionary;
+
+    static auto to_bytes(value_type const &value) -> std::vector<std::byte>
+    {
+        auto const serialized = ValueTrait::to_bytes(value);
+        std::span<std::byte const> const input{
+            serialized.data(), serialized.size()};
+
+        std::vector<std::byte> bytes;
+        if (input.size() >= MinSize) {
+            auto const dictionary = Dictionary::bytes();
+            bytes.push_back(
+                static_cast<std::byte>(
+                    dictionary.empty()
+                        ? details::compression_header::compressed
+                        : details::compression_header::
+                            compressed_with_dictionary));
+            if (!dictionary.empty()) {
+                details::write_dictionary_id(
+                    details::get_dictionary_id<Dictionary>(), bytes);
+            }
+            details::write_varint(input.size(), bytes);
+            if constexpr (details::has_prepared_dictionary_v<
+                              Dictionary,
+                              Codec>)
+                Codec::compress_prepared(input, Dictionary::prepared(), bytes);
+            else
+                Codec::compress(input, dictionary, bytes);
+            if (bytes.size() <= input.size()) {
+                record(input.size(), bytes.size(), true);
+                return bytes;
+            }
+            bytes.clear();
+        }
+
+        bytes.reserve(input.size() + 1);
+        bytes.push_back(
+            static_cast<std::byte>(details::compression_header::raw));
+        bytes.insert(bytes.end(), input.begin(), input.end());
+        record(input.size(), bytes.size(), false);
+        return bytes;
+    }
+
+    // corrupted for a stored value which cannot be decompressed,
+    // incompatible when the dictionary it was compressed with is not
+    // installed
+    static auto try_from_bytes(std::span<std::byte const> const &bytes)
+        -> std::expected<value_type, error_t>
+    {
+        if (bytes.empty())
+            return std::unexpected{error_t::corrupted};
+
+        auto const header
+            = static_cast<details::compression_header>(bytes.front());
+        auto payload = bytes.subspan(1);
+        if (header == details::compression_header::raw)
+            return ValueTrait::from_bytes(payload);
+
+        std::span<std::byte const> dictionary;
+        if (header == details::compression_header::compressed_with_dictionary)
+        {
+            auto const id = details::read_dictionary_id(payload);
+            if (!id)
+                return std::unexpected{error_t::corrupted};
+
+            dictionary = Dictionary::bytes();
+            if (dictionary.empty()
+                || *id != details::get_dictionary_id<Dictionary>())
+                return std::unexpected{error_t::incompatible};
+        } else if (header != details::compression_header::compressed) {
+            return std::unexpected{error_t::corrupted};
+        }
+
+        // LZ sequences expand at most 255 times, bounding the buffer when
+        // the size is corrupted
+        auto const size = details::read_varint(payload);
+        if (!size || *size / 255 > payload.size())
+            return std::unexpected{error_t::corrupted};
+
+        thread_local std::vector<std::byte> buffer;
+        buffer.clear();
+        buffer.reserve(*size);
+        if (!Codec::decompress(payload, dictionary, buffer)
+            || buffer.size() != *size)
+            return std::unexpected{error_t::corrupted};
+
+        return ValueTrait::from_bytes(buffer);
+    }
+
+    static auto from_bytes(std::span<std::byte const> const &bytes)
+        -> value_type
+    {
+        auto value = try_from_bytes(bytes);
+        if (!value) {
+            throw std::runtime_error{
+                value.error() == error_t::incompatible
+                    ? "compression dictionary missing or replaced"
+                    : "corrupted compressed value"};
+        }
+        return std::move(*value);
+    }
+
+    // totals of the values serialized since the start or the last reset
+    static auto stats() noexcept -> compression_stats_t
+    {
+        return {
+            .values = _stats.values.load(std::memory_order_relaxed),
+            .compressed_values
+            = _stats.compressed_values.load(std::memory_order_relaxed),
+            .input_bytes = _stats.input_bytes.load(std::memory_order_relaxed),
+            .stored_bytes
+            = _stats.stored_bytes.load(std::memory_order_relaxed),
+        };
+    }
+
+    static auto reset_stats() noexcept -> void
+    {
+        _stats.values.store(0, std::memory_order_relaxed);
+        _stats.compressed_values.store(0, std::memory_order_relaxed);
+        _stats.input_bytes.store(0, std::memory_order_relaxed);
+        _stats.stored_bytes.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    struct atomic_stats {
+        std::atomic<size_t> values;
+        std::atomic<size_t> compressed_values;
+        std::atomic<size_t> input_bytes;
+        std::atomic<size_t> stored_bytes;
+    };
+    inline static atomic_stats _stats{};
+
+    static auto record(
+        size_t const input_size, size_t const stored_size, bool const packed)
+        -> void
+    {
+        _stats.values.fetch_add(1, std::memory_order_relaxed);
+        if (packed)
+            _stats.compressed_values.fetch_add(1, std::memory_order_relaxed);
+        _stats.input_bytes.fetch_add(input_size, std::memory_order_relaxed);
+        _stats.stored_bytes.fetch_add(stored_size, std::memory_order_relaxed);
+    }
+};
+
+// Installs the dictionary stored under name in the dictionaries db into
+// the trained_dictionary of db's compressed value trait.
+template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi>
+    requires details::is_trained_dictionary_v<
+        typename KeyValueTrait::value_trait::dictionary_type>
+auto load_dictionary(
+    ro_db<dictionary_db_trait, LmdbApi> const &dictionaries,
+    std::string const &name,
+    ro_db<KeyValueTrait, LmdbApi> const & /*db*/)
+    -> std::expected<void, error_t>
+{
+    using dictionary_type =
+        typename KeyValueTrait::value_trait::dictionary_type;
+
+    auto const txn = dictionaries.begin_ro_transaction();
+    if (!txn)
+        return std::unexpected{txn.error()};
+
+    auto dictionary = txn->get(name);
+    if (!dictionary)
+        return std::unexpected{dictionary.error()};
+
+    dictionary_type::install(std::move(*dictionary));
+    return {};
+}
+
+// Trains a dictionary on a sample of the values of db, stores it under name
+// in the dictionaries db and installs it, values written from then on are
+// compressed with it. Values written before stay readable. A dictionary
+// already stored under name is loaded instead of being retrained, since
+// the values compressed with it can only be read with it. Fails with
+// not_found when db holds no values to train on.
+template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi>
+    requires details::is_trained_dictionary_v<
+        typename KeyValueTrait::value_trait::dictionary_type>
+auto train_dictionary(
+    rw_db<dictionary_db_trait, LmdbApi> &dictionaries,
+    std::string const &name,
+    ro_db<KeyValueTrait, LmdbApi> const &db,
+    dictionary_options_t const &options = {}) -> std::expected<void, error_t>
+{
+    using value_trait = typename KeyValueTrait::value_trait;
+    using inner_trait = typename value_trait::inner_trait;
+
+    if (auto const loaded = load_dictionary(dictionaries, name, db);
+        loaded || loaded.error() != error_t::not_found)
+        return loaded;
+
+    // reservoir sample of the serialized values
+    std::vector<std::vector<std::byte>> samples;
+    {
+        auto const txn = db.begin_ro_transaction();
+        if (!txn)
+            return std::unexpected{txn.error()};
+        auto const view = txn->iterate();
+        if (!view)
+            return std::unexpected{view.error()};
+
+        std::minstd_rand random{};
+        size_t seen{};
+        for (auto const &item : *view) {
+            // serializations may refer to the value they were made of
+            auto const value = item.value();
+            auto const serialized = inner_trait::to_bytes(value);
+            std::vector<std::byte> sample{
+                serialized.data(), serialized.data() + serialized.size()};
+
+            if (samples.size() < options.sample_count) {
+                samples.push_back(std::move(sample));
+            } else if (auto const slot
+                       = std::uniform_int_distribution<size_t>{0, seen}(
+                           random);
+                       slot < options.sample_count) {
+                samples[slot] = std::move(sample);
+            }
+            ++seen;
+        }
+    }
+
+    auto dictionary = details::build_dictionary(samples, options);
+    if (dictionary.empty())
+        return std::unexpected{error_t::not_found};
+
+    auto txn = dictionaries.begin_rw_transaction();
+    if (!txn)
+        return std::unexpected{txn.error()};
+    if (auto const result = txn->insert(name, dictionary); !result)
+        return result;
+    if (auto const result = dictionaries.commit_transaction(std::move(*txn));
+        !result)
+        return result;
+
+    value_trait::dictionary_type::install(std::move(dictionary));
+    return {};
+}
+
+}  // namespace lmdb
@@ -23,6 +23,26 @@ concept lmdb_api_like = requires(Api api) {
         std::declval<MDB_dbi>())
     }  -> std::same_as<int>;
 
+    { api.mdb_env_set_mapsize(
+        std::declval<MDB_env *>(),
+        std::declval<size_t>())
+    }  -> std::same_as<int>;
+
+    { api.mdb_env_set_maxreaders(
+        std::declval<MDB_env *>(),
+        std::declval<unsigned int>())
+    }  -> std::same_as<int>;
+
+    { api.mdb_env_info(
+        std::declval<MDB_env *>(),
+        std::declval<MDB_envinfo *>())
+    }  -> std::same_as<int>;
+
+    { api.mdb_env_stat(
+        std::declval<MDB_env *>(),
+        std::declval<MDB_stat *>())
+    }  -> std::same_as<int>;
+
     { api.mdb_txn_begin(
         std::declval<MDB_env *>(),
         std::declval<MDB_txn*>(), 
@@ -32,6 +52,10 @@ concept lmdb_api_like = requires(Api api) {
     
     { api.mdb_txn_abort(std::declval<MDB_txn *>()) } -> std::same_as<void>;
     { api.mdb_txn_commit(std::declval<MDB_txn *>()) } -> std::same_as<int>;
+    { api.mdb_txn_reset(std::declval<MDB_txn *>()) } -> std::same_as<void>;
+    { api.mdb_txn_renew(std::declval<MDB_txn *>()) } -> std::same_as<int>;
+    { api.mdb_txn_env(std::declval<MDB_txn *>()) } -> std::same_as<MDB_env *>;
+    { api.mdb_txn_id(std::declval<MDB_txn *>()) } -> std::same_as<size_t>;
 
     { api.mdb_dbi_open(
         std::declval<MDB_txn *>(), 
@@ -46,6 +70,12 @@ concept lmdb_api_like = requires(Api api) {
         std::declval<int>()
     ) } -> std::same_as<int>;
 
+    { api.mdb_stat(
+        std::declval<MDB_txn *>(),
+        std::declval<MDB_dbi>(),
+        std::declval<MDB_stat*>()
+    ) } -> std::same_as<int>;
+
     { api.mdb_set_compare(
         std::declval<MDB_txn *>(), 
         std::declval<MDB_dbi>(),
@@ -80,6 +110,13 @@ concept lmdb_api_like = requires(Api api) {
         std::declval<MDB_val*>()
     ) } -> std::same_as<int>;
 
+    { api.mdb_cmp(
+        std::declval<MDB_txn *>(),
+        std::declval<MDB_dbi>(),
+        std::declval<MDB_val const*>(),
+        std::declval<MDB_val const*>()
+    ) } -> std::same_as<int>;
+
     { api.mdb_cursor_open(
         std::declval<MDB_txn *>(), 
         std::declval<MDB_dbi>(),
@@ -90,6 +127,11 @@ concept lmdb_api_like = requires(Api api) {
         std::declval<MDB_cursor*>()
     ) } -> std::same_as<void>;
 
+    { api.mdb_cursor_renew(
+        std::declval<MDB_txn*>(),
+        std::declval<MDB_cursor*>()
+    ) } -> std::same_as<int>;
+
     { api.mdb_cursor_get(
         std::declval<MDB_cursor*>(),
         std::declval<MDB_val*>(),
@@ -97,6 +139,13 @@ concept lmdb_api_like = requires(Api api) {
         std::declval<MDB_cursor_op>()
 
     ) } -> std::same_as<int>;
+
+    { api.mdb_cursor_put(
+        std::declval<MDB_cursor*>(),
+        std::declval<MDB_val*>(),
+        std::declval<MDB_val*>(),
+        std::declval<unsigned int>()
+    ) } -> std::same_as<int>;
 };
 // clang-format on
 
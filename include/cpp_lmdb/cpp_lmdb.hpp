@@ -1,12 +1,28 @@
 #pragma once
 
+#include "cpp_lmdb/async.hpp"
+#include "cpp_lmdb/compressed_trait.hpp"
 #include "cpp_lmdb/concepts.hpp"
 #include "cpp_lmdb/db_item.hpp"
 #include "cpp_lmdb/dbs.hpp"
 #include "cpp_lmdb/environment.hpp"
+#include "cpp_lmdb/executor.hpp"
+#include "cpp_lmdb/indexed_table.hpp"
+#include "cpp_lmdb/instrumented_api.hpp"
 #include "cpp_lmdb/iterators.hpp"
+#include "cpp_lmdb/map_growth.hpp"
+#include "cpp_lmdb/membership_filter.hpp"
+#include "cpp_lmdb/multi_transaction.hpp"
+#include "cpp_lmdb/numeric_trait.hpp"
+#include "cpp_lmdb/parallel_scan.hpp"
+#include "cpp_lmdb/pipelined_scan.hpp"
+#include "cpp_lmdb/read_cache.hpp"
+#include "cpp_lmdb/stats.hpp"
 #include "cpp_lmdb/transactions.hpp"
+#include "cpp_lmdb/tuple_key_trait.hpp"
+#include "cpp_lmdb/txn_pool.hpp"
 #include "cpp_lmdb/views.hpp"
+#include "cpp_lmdb/write_coordinator.hpp"
 
 // details
 #include "cpp_lmdb/details/details.hpp"
@@ -32,6 +32,12 @@ public:
         return ValueTrait::from_bytes(_value);
     }
 
+    // the key as stored, without decoding it
+    auto key_bytes() const noexcept -> byte_span
+    {
+        return _key;
+    }
+
 private:
     byte_span _key;
     byte_span _value;
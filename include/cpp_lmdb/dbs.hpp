@@ -1,10 +1,14 @@
 #pragma once
 
 #include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/map_growth.hpp"
+#include "cpp_lmdb/stats.hpp"
 #include "cpp_lmdb/transactions.hpp"
+#include "cpp_lmdb/txn_pool.hpp"
 #include "cpp_lmdb/types.hpp"
 
 // details
+#include "cpp_lmdb/details/commit_listener.hpp"
 #include "cpp_lmdb/details/details.hpp"
 #include "cpp_lmdb/details/key_value_traits.hpp"
 
@@ -12,20 +16,77 @@
 #include "lmdb.h"
 
 // std
+#include <algorithm>
 #include <concepts>
+#include <cstddef>
 #include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace lmdb
 {
+struct bulk_load_options_t {
+    // number of pairs written per transaction
+    size_t chunk_size{16384};
+};
+
+struct bulk_load_error_t {
+    // key_exist means that the input is not sorted in the db order or
+    // repeats a key of a unique_key db (or a pair of a duplicate_key db)
+    error_t error;
+    // index of the pair that failed to be written, empty if beginning or
+    // committing a transaction failed
+    std::optional<size_t> position;
+    // number of leading pairs committed before the failure, i.e. where a
+    // retry restarts
+    size_t committed;
+};
+
 namespace details
 {
+template <typename Range, typename Key, typename Value>
+concept key_value_range
+    = std::ranges::input_range<Range>
+      && std::convertible_to<
+          std::tuple_element_t<0, std::ranges::range_value_t<Range>>,
+          Key>
+      && std::convertible_to<
+          std::tuple_element_t<1, std::ranges::range_value_t<Range>>,
+          Value>;
+
 template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi>
 class db_base {
 public:
-    db_base(LmdbApi const &api, MDB_dbi const db_index, MDB_env &env)
-        : _api{api}, _db_index{db_index}, _env{env}
+    db_base(
+        LmdbApi const &api,
+        MDB_dbi const db_index,
+        MDB_env &env,
+        std::optional<map_growth_policy_t> const &growth_policy = std::nullopt,
+        details::map_resize_guard *const resize_guard = nullptr)
+        : _api{api}
+        , _db_index{db_index}
+        , _env{env}
+        , _growth_policy{growth_policy}
+        , _resize_guard{resize_guard}
     {}
 
+    auto db_index() const noexcept -> MDB_dbi
+    {
+        return _db_index;
+    }
+
+    auto set_map_growth_policy(
+        std::optional<map_growth_policy_t> const &growth_policy) noexcept
+    {
+        _growth_policy = growth_policy;
+    }
+
 protected:
     template <read_only_t ReadOnly>
     using transaction = transaction<KeyValueTrait, ReadOnly, LmdbApi>;
@@ -34,17 +95,91 @@ protected:
     auto make_transaction() const
         -> std::expected<transaction<ReadOnly>, error_t>
     {
-        auto txn = details::make_tx<LmdbApi>(_api, _env, ReadOnly);
+        for (size_t attempt{};; ++attempt) {
+            auto const generation = resize_generation();
+            auto txn = details::make_tx<LmdbApi>(
+                _api, _env, ReadOnly, nullptr, _resize_guard);
+            if (txn)
+                return transaction<ReadOnly>{_db_index, std::move(*txn)};
+
+            if (txn.error() != MDB_MAP_RESIZED || !_growth_policy
+                || attempt >= _growth_policy->max_retries)
+                return std::unexpected{error_t{txn.error()}};
+
+            if (auto const result = resize_map(
+                    generation,
+                    error_t::map_resized,
+                    [this] { return details::adopt_resized_map(_api, _env); });
+                !result)
+                return std::unexpected{result.error()};
+        }
+    }
+
+    auto make_pooled_transaction(ro_txn_pool<LmdbApi> &pool) const
+        -> std::expected<transaction<read_only_t::yes>, error_t>
+    {
+        auto txn = pool.acquire();
         if (!txn)
             return std::unexpected{error_t{txn.error()}};
 
-        return transaction<ReadOnly>{_db_index, std::move(txn.value())};
+        return transaction<read_only_t::yes>{
+            _db_index, std::move(txn.value()), &pool.cursors()};
+    }
+
+    auto api() const noexcept -> LmdbApi const &
+    {
+        return _api;
+    }
+
+    auto env() const noexcept -> MDB_env &
+    {
+        return _env;
+    }
+
+    auto growth_policy() const noexcept
+        -> std::optional<map_growth_policy_t> const &
+    {
+        return _growth_policy;
+    }
+
+    // number of changes of the map size so far
+    auto resize_generation() const noexcept -> size_t
+    {
+        return _resize_guard != nullptr ? _resize_guard->generation.load()
+                                        : 0;
+    }
+
+    // Runs resize once the other transactions of the environment have
+    // ended, unless the map was resized after generation was read. Requires
+    // a growth policy.
+    template <std::invocable Fn>
+    auto resize_map(
+        size_t const generation, error_t const timeout_error, Fn &&resize)
+        const -> std::expected<void, error_t>
+    {
+        if (_resize_guard == nullptr)
+            return std::invoke(resize);
+
+        std::unique_lock lock{_resize_guard->mutex, std::defer_lock};
+        if (!lock.try_lock_for(_growth_policy->max_resize_wait))
+            return std::unexpected{timeout_error};
+
+        if (_resize_guard->generation.load() != generation)
+            return {};
+
+        if (auto const result = std::invoke(resize); !result)
+            return result;
+
+        _resize_guard->generation.fetch_add(1);
+        return {};
     }
 
 private:
     LmdbApi const &_api;
     MDB_dbi const _db_index;
     MDB_env &_env;
+    std::optional<map_growth_policy_t> _growth_policy;
+    details::map_resize_guard *_resize_guard;
 };
 }  // namespace details
 
@@ -66,13 +201,34 @@ public:
     {
         return base::template make_transaction<read_only_t::yes>();
     }
+
+    auto begin_ro_transaction(ro_txn_pool<LmdbApi> &pool) const
+        -> std::expected<ro_transaction, error_t>
+    {
+        return base::make_pooled_transaction(pool);
+    }
+
+    // statistics of the latest snapshot of the db
+    auto stats() const -> std::expected<db_stats_t, error_t>
+    {
+        auto const txn = begin_ro_transaction();
+        if (!txn)
+            return std::unexpected{txn.error()};
+
+        return txn->stats();
+    }
 };
 
 template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi>
 class rw_db : public ro_db<KeyValueTrait, LmdbApi> {
     using base = ro_db<KeyValueTrait, LmdbApi>;
 
+    using key_trait = typename KeyValueTrait::key_trait;
+
 public:
+    using typename base::key_type;
+    using typename base::value_type;
+
     using rw_transaction
         = transaction<KeyValueTrait, read_only_t::no, LmdbApi>;
 
@@ -81,14 +237,194 @@ public:
 
     auto begin_rw_transaction() -> std::expected<rw_transaction, error_t>
     {
-        return base::template make_transaction<read_only_t::no>();
+        auto transaction = base::template make_transaction<read_only_t::no>();
+        if (!transaction)
+            return transaction;
+
+        std::lock_guard const lock{*_listeners_mutex};
+        if (!_commit_listeners.empty())
+            transaction->track_written_keys();
+        return transaction;
     }
 
     auto commit_transaction(rw_transaction &&transaction)
         -> std::expected<void, error_t>
     {
-        return std::move(transaction).commit();
+        // held while notifying, so a removed listener is no longer called
+        std::lock_guard const lock{*_listeners_mutex};
+        if (_commit_listeners.empty())
+            return std::move(transaction).commit();
+
+        auto const txn_id = transaction.id();
+        auto const *const keys = transaction.written_keys();
+        for (auto *const listener : _commit_listeners) {
+            if (auto const result = listener->before_commit(
+                    base::api(), transaction.handle(), keys);
+                !result)
+                return result;
+        }
+
+        if (auto const result = std::move(transaction).commit(); !result)
+            return result;
+
+        for (auto *const listener : _commit_listeners)
+            listener->on_commit(txn_id, keys);
+        return {};
+    }
+
+    // Notifies listener of the transactions committed through this handle,
+    // e.g. a read_cache; writes through multi_transaction are not reported.
+    // The listener must outlive the handle or be removed first. Listeners
+    // may be added and removed concurrently with commits, but not from
+    // their own callbacks.
+    auto add_commit_listener(
+        details::commit_listener<LmdbApi> *const listener) -> void
+    {
+        std::lock_guard const lock{*_listeners_mutex};
+        _commit_listeners.push_back(listener);
+    }
+
+    auto remove_commit_listener(
+        details::commit_listener<LmdbApi> *const listener) noexcept -> void
+    {
+        std::lock_guard const lock{*_listeners_mutex};
+        std::erase(_commit_listeners, listener);
+    }
+
+    // Loads pairs sorted in the db order by appending them at the end of
+    // the tree (MDB_APPEND, MDB_APPENDDUP for duplicates) instead of
+    // searching for the insert position, in transactions of
+    // options.chunk_size pairs. Keys must sort after the existing keys.
+    template <details::key_value_range<key_type, value_type> Range>
+    auto bulk_load(Range &&pairs, bulk_load_options_t const &options = {})
+        -> std::expected<size_t, bulk_load_error_t>
+    {
+        constexpr bool duplicates_enabled = details::key_value_trait_helper<
+            KeyValueTrait>::duplicates_enabled;
+
+        auto const chunk_size = std::max(options.chunk_size, size_t{1});
+        std::optional<rw_transaction> transaction;
+        std::vector<std::byte> previous_key;
+        size_t position{};
+        size_t committed{};
+
+        auto const fail
+            = [&](error_t const error, std::optional<size_t> const failed) {
+                  return std::unexpected{
+                      bulk_load_error_t{error, failed, committed}};
+              };
+
+        for (auto &&[key, value] : pairs) {
+            if (!transaction) {
+                auto begun = begin_rw_transaction();
+                if (!begun)
+                    return fail(begun.error(), std::nullopt);
+                transaction.emplace(std::move(*begun));
+            }
+
+            auto const key_bytes = key_trait::to_bytes(key);
+            auto flags = static_cast<unsigned int>(MDB_APPEND);
+            if constexpr (duplicates_enabled) {
+                if (std::ranges::equal(key_bytes, previous_key))
+                    flags = MDB_APPENDDUP;
+                previous_key.assign(key_bytes.begin(), key_bytes.end());
+            }
+
+            if (auto const result
+                = transaction->insert_impl(key, value, flags);
+                !result)
+                return fail(result.error(), position);
+
+            if (++position % chunk_size == 0) {
+                if (auto const result = commit_transaction(
+                        std::move(*std::exchange(transaction, std::nullopt)));
+                    !result)
+                    return fail(result.error(), std::nullopt);
+                committed = position;
+            }
+        }
+
+        if (transaction) {
+            if (auto const result
+                = commit_transaction(std::move(*transaction));
+                !result)
+                return fail(result.error(), std::nullopt);
+        }
+
+        return position;
+    }
+
+    // Runs fn in a write transaction and commits it. With a map growth
+    // policy set, a transaction failed with map_full is aborted, the map is
+    // grown and fn is replayed in a fresh transaction. Growing the map waits
+    // for the other transactions of the environment to end (see
+    // map_growth_policy_t::max_resize_wait), so the calling thread must not
+    // hold one.
+    template <std::invocable<rw_transaction &> Fn>
+    auto write(Fn &&fn) -> std::expected<void, error_t>
+        requires std::same_as<
+            std::invoke_result_t<Fn, rw_transaction &>,
+            std::expected<void, error_t>>
+    {
+        for (size_t attempt{};; ++attempt) {
+            auto const generation = base::resize_generation();
+            auto const result = write_once(fn, generation);
+            auto const &policy = base::growth_policy();
+            if (result || result.error() != error_t::map_full || !policy
+                || attempt >= policy->max_retries)
+                return result;
+
+            // a concurrent writer that failed too may have grown the map
+            if (auto const grown = base::resize_map(
+                    generation,
+                    error_t::map_full,
+                    [this, &policy] {
+                        return details::grow_map(
+                            base::api(), base::env(), *policy);
+                    });
+                !grown)
+                return grown;
+        }
+    }
+
+private:
+    template <typename Fn>
+    auto write_once(Fn &fn, size_t const generation)
+        -> std::expected<void, error_t>
+    {
+        if (auto const &policy = base::growth_policy(); policy) {
+            auto const map_size = details::map_size_with_headroom(
+                base::api(), base::env(), *policy);
+            if (!map_size)
+                return std::unexpected{map_size.error()};
+
+            if (*map_size) {
+                if (auto const reserved = base::resize_map(
+                        generation,
+                        error_t::map_full,
+                        [this, &map_size] {
+                            return details::set_map_size(
+                                base::api(), base::env(), **map_size);
+                        });
+                    !reserved)
+                    return reserved;
+            }
+        }
+
+        auto transaction = begin_rw_transaction();
+        if (!transaction)
+            return std::unexpected{transaction.error()};
+
+        if (auto const result = std::invoke(fn, *transaction); !result)
+            return result;
+
+        return commit_transaction(std::move(*transaction));
     }
+
+    // boxed to keep the handle movable
+    std::unique_ptr<std::mutex> _listeners_mutex{
+        std::make_unique<std::mutex>()};
+    std::vector<details::commit_listener<LmdbApi> *> _commit_listeners;
 };
 
 }  // namespace lmdb
@@ -21,19 +21,31 @@ struct api {
 
     FORWARD_CALL(mdb_txn_abort, ::mdb_txn_abort);
     FORWARD_CALL(mdb_txn_commit, ::mdb_txn_commit);
+    FORWARD_CALL(mdb_txn_reset, ::mdb_txn_reset);
+    FORWARD_CALL(mdb_txn_renew, ::mdb_txn_renew);
+    FORWARD_CALL(mdb_txn_env, ::mdb_txn_env);
+    FORWARD_CALL(mdb_txn_id, ::mdb_txn_id);
     FORWARD_CALL(mdb_env_set_maxdbs, ::mdb_env_set_maxdbs);
+    FORWARD_CALL(mdb_env_set_mapsize, ::mdb_env_set_mapsize);
+    FORWARD_CALL(mdb_env_set_maxreaders, ::mdb_env_set_maxreaders);
+    FORWARD_CALL(mdb_env_info, ::mdb_env_info);
+    FORWARD_CALL(mdb_env_stat, ::mdb_env_stat);
 
     FORWARD_CALL(mdb_dbi_open, ::mdb_dbi_open);
     FORWARD_CALL(mdb_drop, ::mdb_drop);
+    FORWARD_CALL(mdb_stat, ::mdb_stat);
 
     FORWARD_CALL(mdb_set_compare, ::mdb_set_compare);
     FORWARD_CALL(mdb_set_dupsort, ::mdb_set_dupsort);
     FORWARD_CALL(mdb_put, ::mdb_put);
     FORWARD_CALL(mdb_get, ::mdb_get);
+    FORWARD_CALL(mdb_cmp, ::mdb_cmp);
     FORWARD_CALL(mdb_del, ::mdb_del);
     FORWARD_CALL(mdb_cursor_open, ::mdb_cursor_open);
     FORWARD_CALL(mdb_cursor_close, ::mdb_cursor_close);
+    FORWARD_CALL(mdb_cursor_renew, ::mdb_cursor_renew);
     FORWARD_CALL(mdb_cursor_get, ::mdb_cursor_get);
+    FORWARD_CALL(mdb_cursor_put, ::mdb_cursor_put);
     // NOLINTEND(modernize-use-trailing-return-type)
 };
 
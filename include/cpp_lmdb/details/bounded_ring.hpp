@@ -0,0 +1,106 @@
+#pragma once
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace lmdb::details
+{
+
+inline constexpr size_t cache_line_size{64};
+
+// Bounded lock-free multi-producer multi-consumer ring (D. Vyukov). Every
+// slot carries a sequence number telling whether it is free for the
+// current lap of the writers or holds an item for the current lap of the
+// readers. A full or an empty ring is waited for with an atomic wait on
+// the sequence of the blocking slot, so idle threads do not spin.
+template <typename T>
+class bounded_ring {
+public:
+    // the capacity is rounded up to a power of two
+    explicit bounded_ring(size_t const capacity)
+        : _slots(std::bit_ceil(std::max<size_t>(capacity, 2)))
+        , _mask{_slots.size() - 1}
+    {
+        for (size_t i = 0; i < _slots.size(); ++i)
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    bounded_ring(bounded_ring const &) = delete;
+    auto operator=(bounded_ring const &) -> bounded_ring & = delete;
+
+    auto push(T value) -> void
+    {
+        auto position = _write_position.load(std::memory_order_relaxed);
+        while (true) {
+            auto &slot = _slots[position & _mask];
+            auto const sequence
+                = slot.sequence.load(std::memory_order_acquire);
+            auto const lap = static_cast<std::ptrdiff_t>(sequence - position);
+
+            if (lap == 0) {
+                if (_write_position.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = std::move(value);
+                    slot.sequence.store(
+                        position + 1, std::memory_order_release);
+                    slot.sequence.notify_all();
+                    return;
+                }
+                continue;
+            }
+
+            // full, the slot is freed by the reader of the previous lap
+            if (lap < 0)
+                slot.sequence.wait(sequence, std::memory_order_acquire);
+            position = _write_position.load(std::memory_order_relaxed);
+        }
+    }
+
+    auto pop() -> T
+    {
+        auto position = _read_position.load(std::memory_order_relaxed);
+        while (true) {
+            auto &slot = _slots[position & _mask];
+            auto const sequence
+                = slot.sequence.load(std::memory_order_acquire);
+            auto const lap
+                = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+            if (lap == 0) {
+                if (_read_position.compare_exchange_weak(
+                        position, position + 1, std::memory_order_relaxed)) {
+                    auto value = std::move(slot.value);
+                    slot.sequence.store(
+                        position + _mask + 1, std::memory_order_release);
+                    slot.sequence.notify_all();
+                    return value;
+                }
+                continue;
+            }
+
+            // empty, the slot is filled by the writer of the current lap
+            if (lap < 0)
+                slot.sequence.wait(sequence, std::memory_order_acquire);
+            position = _read_position.load(std::memory_order_relaxed);
+        }
+    }
+
+private:
+    struct alignas(cache_line_size) slot {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::vector<slot> _slots;
+    size_t const _mask;
+
+    alignas(cache_line_size) std::atomic<size_t> _write_position{};
+    alignas(cache_line_size) std::atomic<size_t> _read_position{};
+};
+
+}  // namespace lmdb::details
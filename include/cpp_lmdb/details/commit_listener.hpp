@@ -0,0 +1,51 @@
+#pragma once
+
+#include "cpp_lmdb/error.hpp"
+
+// lmdb
+#include "lmdb.h"
+
+// std
+#include <cstddef>
+#include <expected>
+#include <vector>
+
+namespace lmdb
+{
+namespace details
+{
+// encoded keys written by a transaction, in write order
+using written_keys_t = std::vector<std::vector<std::byte>>;
+
+// keys recorded for a transaction and its nested transactions, unknown once
+// recording a key failed
+struct written_keys_record {
+    written_keys_t keys;
+    bool complete{true};
+};
+
+// Notified by rw_db::commit_transaction of the transactions of a db. keys
+// is null when the written keys are unknown, e.g. for transactions begun
+// before the listener was added or when recording them ran out of memory.
+template <typename LmdbApi>
+class commit_listener {
+public:
+    virtual ~commit_listener() = default;
+
+    // called in the write transaction right before it is committed, e.g. to
+    // update a side db in the same MDB_txn; an error aborts the commit
+    virtual auto before_commit(
+        LmdbApi const & /*api*/,
+        MDB_txn * /*txn*/,
+        written_keys_t const * /*keys*/) -> std::expected<void, error_t>
+    {
+        return {};
+    }
+
+    // called after the commit, txn_id is the id of the snapshot it created
+    virtual auto on_commit(
+        size_t /*txn_id*/, written_keys_t const * /*keys*/) noexcept -> void
+    {}
+};
+}  // namespace details
+}  // namespace lmdb
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "cpp_lmdb/types.hpp"
+
+// lmdb
+#include "lmdb.h"
+
+// std
+#include <array>
+#include <cstddef>
+#include <expected>
+#include <mutex>
+
+namespace lmdb::details
+{
+
+// Small per-DBI cache of open cursors. Read-only cursors are rebound with
+// mdb_cursor_renew, so they can be reused by any read-only transaction,
+// e.g. after the transaction has been reset and renewed by ro_txn_pool.
+// Cursors of a write transaction must be closed before the transaction
+// ends, so a cache used with a write transaction must be destroyed first.
+template <typename LmdbApi, size_t Capacity = 4>
+class cursor_cache {
+public:
+    cursor_cache(LmdbApi const &api, read_only_t const read_only) noexcept
+        : _api{api}, _read_only{read_only}
+    {}
+
+    cursor_cache(cursor_cache const &) = delete;
+    auto operator=(cursor_cache const &) -> cursor_cache & = delete;
+
+    ~cursor_cache()
+    {
+        for (size_t i = 0; i < _size; ++i)
+            _api.mdb_cursor_close(_entries[i].cursor);
+    }
+
+    auto acquire(MDB_txn *const txn, MDB_dbi const dbi)
+        -> std::expected<MDB_cursor *, int>
+    {
+        if (auto *cursor = pop(dbi)) {
+            if (_read_only == read_only_t::no)
+                return cursor;
+
+            if (auto const result = _api.mdb_cursor_renew(txn, cursor);
+                result == MDB_SUCCESS)
+                return cursor;
+
+            _api.mdb_cursor_close(cursor);
+        }
+
+        MDB_cursor *cursor{nullptr};
+        if (auto const result = _api.mdb_cursor_open(txn, dbi, &cursor);
+            result != MDB_SUCCESS) {
+            return std::unexpected{result};
+        }
+
+        return cursor;
+    }
+
+    auto release(MDB_dbi const dbi, MDB_cursor *const cursor) noexcept
+        -> void
+    {
+        {
+            std::lock_guard const lock{_mutex};
+            if (_size < Capacity) {
+                _entries[_size++] = entry{dbi, cursor};
+                return;
+            }
+        }
+
+        _api.mdb_cursor_close(cursor);
+    }
+
+private:
+    struct entry {
+        MDB_dbi dbi;
+        MDB_cursor *cursor;
+    };
+
+    auto pop(MDB_dbi const dbi) -> MDB_cursor *
+    {
+        std::lock_guard const lock{_mutex};
+        for (size_t i = _size; i > 0; --i) {
+            if (_entries[i - 1].dbi == dbi) {
+                auto *cursor = _entries[i - 1].cursor;
+                _entries[i - 1] = _entries[--_size];
+                return cursor;
+            }
+        }
+
+        return nullptr;
+    }
+
+    LmdbApi const &_api;
+    read_only_t const _read_only;
+
+    std::mutex _mutex;
+    std::array<entry, Capacity> _entries{};
+    size_t _size{};
+};
+
+}  // namespace lmdb::details
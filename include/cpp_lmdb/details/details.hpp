@@ -2,14 +2,27 @@
 
 #include "cpp_lmdb/types.hpp"
 
+// details
+#include "cpp_lmdb/details/cursor_cache.hpp"
+
 // lmdb
 #include "lmdb.h"
 
 // std
+#include <atomic>
+#include <cstddef>
 #include <expected>
 #include <memory>
+#include <shared_mutex>
 #include <span>
 #include <type_traits>
+#include <utility>
+
+namespace lmdb
+{
+template <typename LmdbApi>
+class ro_txn_pool;
+}  // namespace lmdb
 
 namespace lmdb::details
 {
@@ -43,14 +56,32 @@ auto cmp(MDB_val const *lhs, MDB_val const *rhs) -> int
     return Trait::cmp(to_byte_span(*lhs), to_byte_span(*rhs));
 }
 
+// LMDB allows changing the map size only while no transaction of the
+// process is active. Transactions of an environment hold its guard shared
+// for their lifetime, changes of the map size hold it exclusively.
+struct map_resize_guard {
+    std::shared_timed_mutex mutex;
+    // incremented by each change of the map size
+    std::atomic<size_t> generation{};
+};
+
+using map_resize_lock_t = std::shared_lock<std::shared_timed_mutex>;
+
 template <typename LmdbApi>
 struct txn_deleter {
     auto operator()(MDB_txn *txn) noexcept -> void
     {
-        api.mdb_txn_abort(txn);
+        if (pool != nullptr)
+            pool->release(txn);
+        else
+            api.mdb_txn_abort(txn);
     }
 
     LmdbApi const &api;
+    // pooled read-only transactions are reset and handed back to the pool
+    ro_txn_pool<LmdbApi> *pool{};
+    // released with the deleter, i.e. after the txn ended
+    map_resize_lock_t resize_lock{};
 };
 
 template <typename LmdbApi>
@@ -58,30 +89,41 @@ using txn_unique_ptr_t = std::unique_ptr<MDB_txn, txn_deleter<LmdbApi>>;
 
 template <typename LmdbApi>
 constexpr auto make_tx(
-    LmdbApi const &api, MDB_env &env, read_only_t const read_only)
+    LmdbApi const &api,
+    MDB_env &env,
+    read_only_t const read_only,
+    MDB_txn *const parent = nullptr,
+    map_resize_guard *const resize_guard = nullptr)
     -> std::expected<txn_unique_ptr_t<LmdbApi>, int>
 {
+    map_resize_lock_t resize_lock;
+    if (resize_guard != nullptr)
+        resize_lock = map_resize_lock_t{resize_guard->mutex};
+
     MDB_txn *txn{nullptr};
     if (auto const result = api.mdb_txn_begin(
             &env,
-            nullptr,
+            parent,
             read_only == read_only_t::yes ? MDB_RDONLY : 0,
             &txn);
         result != MDB_SUCCESS) {
         return std::unexpected{result};
     }
 
-    return txn_unique_ptr_t<LmdbApi>{txn, details::txn_deleter<LmdbApi>{api}};
+    return txn_unique_ptr_t<LmdbApi>{
+        txn,
+        details::txn_deleter<LmdbApi>{api, nullptr, std::move(resize_lock)}};
 }
 
 template <typename LmdbApi>
 constexpr auto commit_tx(LmdbApi const &api, txn_unique_ptr_t<LmdbApi> &&tx)
     -> std::expected<void, int>
 {
-    if (auto const result = api.mdb_txn_commit(tx.release());
-        result != MDB_SUCCESS) {
+    auto const result = api.mdb_txn_commit(tx.release());
+    // the txn has ended whether or not the commit succeeded
+    tx.get_deleter().resize_lock = {};
+    if (result != MDB_SUCCESS)
         return std::unexpected{result};
-    }
 
     return {};
 }
@@ -90,10 +132,16 @@ template <typename LmdbApi>
 struct cursor_deleter {
     auto operator()(MDB_cursor *cursor) noexcept -> void
     {
-        api.get().mdb_cursor_close(cursor);
+        if (cache != nullptr)
+            cache->release(dbi, cursor);
+        else
+            api.get().mdb_cursor_close(cursor);
     }
 
     std::reference_wrapper<LmdbApi const> api;
+    // cached cursors are handed back to the cache instead of being closed
+    cursor_cache<LmdbApi> *cache{};
+    MDB_dbi dbi{};
 };
 
 template <typename LmdbApi>
@@ -114,4 +162,20 @@ constexpr auto make_cursor(
     return cursor_unique_ptr_t<LmdbApi>{cursor, cursor_deleter<LmdbApi>{api}};
 }
 
+template <typename LmdbApi>
+constexpr auto make_cursor(
+    LmdbApi const &api,
+    MDB_txn *const txn,
+    MDB_dbi const dbi,
+    cursor_cache<LmdbApi> &cache)
+    -> std::expected<cursor_unique_ptr_t<LmdbApi>, int>
+{
+    auto cursor = cache.acquire(txn, dbi);
+    if (!cursor)
+        return std::unexpected{cursor.error()};
+
+    return cursor_unique_ptr_t<LmdbApi>{
+        *cursor, cursor_deleter<LmdbApi>{api, &cache, dbi}};
+}
+
 }  // namespace lmdb::details
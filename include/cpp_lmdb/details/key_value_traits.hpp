@@ -1,15 +1,20 @@
 #pragma once
 
+#include "cpp_lmdb/error.hpp"
+
 // lmdb
 #include "lmdb.h"
 
 // std
 #include <concepts>
 #include <cstdint>
+#include <expected>
 #include <cstring>
 #include <span>
 #include <string>
+#include <string_view>
 #include <type_traits>
+#include <vector>
 
 namespace lmdb
 {
@@ -72,6 +77,25 @@ constexpr bool get_fixed_value_size_flag()
         return false;
 }
 
+template <typename T>
+inline constexpr bool has_view_from_bytes_v = requires {
+    typename T::view_type;
+    {
+        T::view_from_bytes(std::declval<std::span<std::byte const>>())
+    } -> std::same_as<typename T::view_type>;
+};
+
+template <typename T>
+inline constexpr bool has_serialize_into_v = requires {
+    typename T::value_type;
+    {
+        T::serialized_size(std::declval<typename T::value_type const &>())
+    } -> std::same_as<size_t>;
+    T::serialize_into(
+        std::declval<typename T::value_type const &>(),
+        std::declval<std::span<std::byte>>());
+};
+
 template <typename T>
 inline constexpr bool is_integer_type_v
     = std::is_same_v<T, unsigned int> || std::is_same_v<T, size_t>;
@@ -141,6 +165,12 @@ struct trivial_trait {
     }
 };
 
+// trivial_trait for values of duplicate_key dbs stored as MDB_DUPFIXED
+template <trivially_serealizable T>
+struct fixed_size_trait : trivial_trait<T> {
+    using fixed_size_flag = std::true_type;
+};
+
 struct string_trait {
     using value_type = std::string;
     static auto to_bytes(std::string const &value)
@@ -155,6 +185,31 @@ struct string_trait {
         return std::string{
             reinterpret_cast<char const *>(bytes.data()), bytes.size()};
     }
+
+    using view_type = std::string_view;
+    static auto view_from_bytes(std::span<std::byte const> const &bytes)
+        -> std::string_view
+    {
+        return std::string_view{
+            reinterpret_cast<char const *>(bytes.data()), bytes.size()};
+    }
+};
+
+// opaque bytes, e.g. the values of side dbs
+struct byte_vector_trait {
+    using value_type = std::vector<std::byte>;
+
+    static auto to_bytes(value_type const &value)
+        -> std::span<std::byte const>
+    {
+        return value;
+    }
+
+    static auto from_bytes(std::span<std::byte const> const &bytes)
+        -> value_type
+    {
+        return {bytes.begin(), bytes.end()};
+    }
 };
 
 template <key_trait K, value_trait V>
@@ -177,6 +232,34 @@ struct duplicate_key : basic_key<K, V> {
 
 namespace details
 {
+// traits deriving from trivial_trait store values as their object
+// representation
+template <typename T>
+constexpr bool has_native_layout()
+{
+    using value_type = typename T::value_type;
+    if constexpr (trivially_serealizable<value_type>)
+        return std::is_base_of_v<trivial_trait<value_type>, T>;
+    else
+        return false;
+}
+
+template <typename T>
+inline constexpr bool has_native_layout_v = has_native_layout<T>();
+
+// Only traits storing values in their native layout may be compared as
+// integers: trivial_trait of unsigned int or size_t, and traits storing
+// other types as native unsigned integers, which set integer_flag.
+template <typename T>
+constexpr bool get_integer_flag()
+{
+    if constexpr (requires { typename T::integer_flag; })
+        return T::integer_flag::value;
+    else
+        return is_integer_type_v<typename T::value_type>
+               && has_native_layout_v<T>;
+}
+
 template <key_value_trait KV>
 struct key_value_trait_helper {
     using key_trait = typename KV::key_trait;
@@ -191,8 +274,8 @@ struct key_value_trait_helper {
     constexpr static bool value_fixed_size
         = get_fixed_value_size_flag<value_trait>();
 
-    constexpr static bool is_integer_key = is_integer_type_v<key_type>;
-    constexpr static bool is_integer_value = is_integer_type_v<value_type>;
+    constexpr static bool is_integer_key = get_integer_flag<key_trait>();
+    constexpr static bool is_integer_value = get_integer_flag<value_trait>();
 
     constexpr static bool has_key_cmp_fun = has_cmp_fun_v<key_trait>;
     constexpr static bool has_value_cmp_fun = has_cmp_fun_v<value_trait>;
@@ -210,9 +293,51 @@ struct key_value_trait_helper {
             flags |= MDB_INTEGERKEY;
         if (is_integer_value)
             flags |= MDB_INTEGERDUP;
+        if (duplicates_enabled && value_fixed_size)
+            flags |= MDB_DUPFIXED;
 
         return flags;
     }
 };
+
+// Deserializes to the trait's view_type, or to the raw bytes if the trait
+// has none. Views point into the map and are only valid while the
+// transaction they were read in is alive.
+template <typename Trait>
+struct borrowed_value {
+    using type = std::span<std::byte const>;
+};
+
+template <typename Trait>
+    requires has_view_from_bytes_v<Trait>
+struct borrowed_value<Trait> {
+    using type = typename Trait::view_type;
+};
+
+template <typename Trait>
+struct borrowed_trait {
+    using value_type = typename borrowed_value<Trait>::type;
+
+    static auto from_bytes(std::span<std::byte const> const &bytes)
+        -> value_type
+    {
+        if constexpr (has_view_from_bytes_v<Trait>)
+            return Trait::view_from_bytes(bytes);
+        else
+            return bytes;
+    }
+};
+
+// Decodes a stored value. Traits whose stored bytes may fail to decode
+// provide try_from_bytes, which reports the failure instead of throwing.
+template <typename Trait>
+auto decode_value(std::span<std::byte const> const &bytes)
+    -> std::expected<typename Trait::value_type, error_t>
+{
+    if constexpr (requires { Trait::try_from_bytes(bytes); })
+        return Trait::try_from_bytes(bytes);
+    else
+        return Trait::from_bytes(bytes);
+}
 }  // namespace details
 }  // namespace lmdb
@@ -0,0 +1,266 @@
+#pragma once
+
+// std
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+namespace lmdb
+{
+
+template <typename T>
+concept compression_codec = requires(
+    std::span<std::byte const> const input,
+    std::span<std::byte const> const dictionary,
+    std::vector<std::byte> &output) {
+    T::compress(input, dictionary, output);
+    {
+        T::decompress(input, dictionary, output)
+    } -> std::same_as<bool>;
+};
+
+// Codecs preparing a dictionary once, e.g. indexing it, to compress with
+// the prepared form instead of the bytes.
+template <typename T>
+concept preparing_codec = compression_codec<T> && requires(
+    std::span<std::byte const> const input,
+    std::span<std::byte const> const dictionary,
+    typename T::prepared_dictionary const &prepared,
+    std::vector<std::byte> &output) {
+    {
+        T::prepare(dictionary)
+    } -> std::same_as<typename T::prepared_dictionary>;
+    T::compress_prepared(input, prepared, output);
+};
+
+// Byte-oriented LZ77 codec in the LZ4 block layout: sequences of a token
+// (literal length << 4 | match length - 4), the literals, a 2-byte
+// little-endian offset and the extra length bytes of nibbles equal to 15.
+// The last sequence only holds literals. Offsets reaching before the start
+// of the data refer to the end of the dictionary, so values sharing
+// content with the dictionary compress even when they are small.
+struct lz_codec {
+    static constexpr size_t min_match{4};
+    static constexpr size_t max_offset{65535};
+
+private:
+    static constexpr unsigned hash_bits{12};
+    static constexpr size_t table_size{size_t{1} << hash_bits};
+
+public:
+    // the reachable end of a dictionary and the positions + 1 of the last
+    // occurrence of each hashed 4 bytes in it; refers to the dictionary
+    struct prepared_dictionary {
+        std::span<std::byte const> bytes;
+        std::array<uint32_t, table_size> table{};
+    };
+
+    static auto prepare(std::span<std::byte const> dictionary)
+        -> prepared_dictionary
+    {
+        if (dictionary.size() > max_offset)
+            dictionary = dictionary.last(max_offset);
+
+        prepared_dictionary prepared{.bytes = dictionary};
+        for (size_t position = 0;
+             position + min_match <= dictionary.size();
+             ++position) {
+            prepared.table[hash(read32(dictionary, position))]
+                = static_cast<uint32_t>(position + 1);
+        }
+        return prepared;
+    }
+
+    // appends the compressed input to output
+    static auto compress(
+        std::span<std::byte const> const input,
+        std::span<std::byte const> const dictionary,
+        std::vector<std::byte> &output) -> void
+    {
+        compress_prepared(input, prepare(dictionary), output);
+    }
+
+    static auto compress_prepared(
+        std::span<std::byte const> const input,
+        prepared_dictionary const &dictionary,
+        std::vector<std::byte> &output) -> void
+    {
+        // matches may start in the dictionary, so positions address the
+        // dictionary followed by the input
+        auto const prefix = dictionary.bytes;
+        auto const size = prefix.size() + input.size();
+        auto const at = [&](size_t const position) {
+            return position < prefix.size() ? prefix[position]
+                                             : input[position - prefix.size()];
+        };
+        auto const load32 = [&](size_t const position) {
+            if (position >= prefix.size())
+                return read32(input, position - prefix.size());
+            if (position + min_match <= prefix.size())
+                return read32(prefix, position);
+
+            std::array<std::byte, sizeof(uint32_t)> bytes{};
+            for (size_t i = 0; i < bytes.size(); ++i)
+                bytes[i] = at(position + i);
+            return read32(bytes, 0);
+        };
+
+        auto table = dictionary.table;
+        auto anchor = prefix.size();
+        auto position = anchor;
+        while (position + min_match <= size) {
+            auto const current = load32(position);
+            auto &slot = table[hash(current)];
+            auto const candidate = static_cast<size_t>(slot);
+            slot = static_cast<uint32_t>(position + 1);
+
+            if (candidate == 0 || position - (candidate - 1) > max_offset
+                || load32(candidate - 1) != current) {
+                ++position;
+                continue;
+            }
+
+            auto const match = candidate - 1;
+            auto length = min_match;
+            while (position + length < size
+                   && at(match + length) == at(position + length))
+                ++length;
+
+            write_sequence(
+                input.subspan(anchor - prefix.size(), position - anchor),
+                position - match,
+                length,
+                output);
+            position += length;
+            anchor = position;
+        }
+
+        write_literals(input.subspan(anchor - prefix.size()), output);
+    }
+
+    // appends the decompressed input to output, false if input is malformed
+    static auto decompress(
+        std::span<std::byte const> const input,
+        std::span<std::byte const> dictionary,
+        std::vector<std::byte> &output) -> bool
+    {
+        if (dictionary.size() > max_offset)
+            dictionary = dictionary.last(max_offset);
+
+        auto const base = output.size();
+        size_t index{};
+        auto const read_length = [&](size_t &length) {
+            uint8_t extra{};
+            do {
+                if (index == input.size())
+                    return false;
+                extra = std::to_integer<uint8_t>(input[index++]);
+                length += extra;
+            } while (extra == 255);
+            return true;
+        };
+
+        while (index < input.size()) {
+            auto const token = std::to_integer<uint8_t>(input[index++]);
+
+            size_t literals = token >> 4U;
+            if (literals == 15 && !read_length(literals))
+                return false;
+            if (input.size() - index < literals)
+                return false;
+            output.insert(
+                output.end(),
+                input.begin() + static_cast<std::ptrdiff_t>(index),
+                input.begin() + static_cast<std::ptrdiff_t>(index + literals));
+            index += literals;
+            if (index == input.size())
+                break;
+
+            if (input.size() - index < 2)
+                return false;
+            auto const offset
+                = std::to_integer<size_t>(input[index])
+                  | std::to_integer<size_t>(input[index + 1]) << 8U;
+            index += 2;
+
+            size_t length = token & 0x0FU;
+            if (length == 15 && !read_length(length))
+                return false;
+            length += min_match;
+
+            auto const produced = output.size() - base;
+            if (offset == 0 || offset > produced + dictionary.size())
+                return false;
+
+            // the match may start in the dictionary and may overlap the
+            // bytes it produces
+            auto from = static_cast<std::ptrdiff_t>(produced)
+                        - static_cast<std::ptrdiff_t>(offset);
+            for (; length > 0 && from < 0; --length, ++from) {
+                output.push_back(dictionary[static_cast<size_t>(
+                    static_cast<std::ptrdiff_t>(dictionary.size()) + from)]);
+            }
+            for (; length > 0; --length, ++from)
+                output.push_back(output[base + static_cast<size_t>(from)]);
+        }
+        return true;
+    }
+
+private:
+    static auto read32(std::span<std::byte const> const data, size_t const at)
+        -> uint32_t
+    {
+        uint32_t value{};
+        std::memcpy(&value, data.data() + at, sizeof(value));
+        return value;
+    }
+
+    static auto hash(uint32_t const value) -> size_t
+    {
+        return (value * 2654435761U) >> (32U - hash_bits);
+    }
+
+    static auto write_length(size_t length, std::vector<std::byte> &output)
+        -> void
+    {
+        for (; length >= 255; length -= 255)
+            output.push_back(std::byte{255});
+        output.push_back(static_cast<std::byte>(length));
+    }
+
+    static auto write_literals(
+        std::span<std::byte const> const literals,
+        std::vector<std::byte> &output,
+        uint8_t const match_nibble = 0) -> void
+    {
+        auto const literal_nibble = std::min<size_t>(literals.size(), 15);
+        output.push_back(
+            static_cast<std::byte>(literal_nibble << 4U | match_nibble));
+        if (literal_nibble == 15)
+            write_length(literals.size() - 15, output);
+        output.insert(output.end(), literals.begin(), literals.end());
+    }
+
+    static auto write_sequence(
+        std::span<std::byte const> const literals,
+        size_t const offset,
+        size_t const length,
+        std::vector<std::byte> &output) -> void
+    {
+        auto const extra = length - min_match;
+        auto const match_nibble
+            = static_cast<uint8_t>(std::min<size_t>(extra, 15));
+        write_literals(literals, output, match_nibble);
+        output.push_back(static_cast<std::byte>(offset & 0xFFU));
+        output.push_back(static_cast<std::byte>(offset >> 8U));
+        if (match_nibble == 15)
+            write_length(extra - 15, output);
+    }
+};
+
+}  // namespace lmdb
@@ -0,0 +1,183 @@
+#pragma once
+
+// std
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Encodings whose memcmp order is the natural order of the values, so that
+// LMDB's default comparator orders the keys without a custom cmp. The mask
+// is either 0x00 or 0xFF, which inverts the bytes and so the order.
+namespace lmdb::details
+{
+
+template <typename T>
+struct ordered_codec;
+
+// Order-preserving bijection between arithmetic values and unsigned
+// integers of the same size.
+template <typename T>
+struct ordered_bits;
+
+template <std::unsigned_integral T>
+    requires(!std::same_as<T, bool>)
+struct ordered_bits<T> {
+    using type = T;
+
+    static constexpr auto to(T const value) noexcept -> type
+    {
+        return value;
+    }
+
+    static constexpr auto from(type const bits) noexcept -> T
+    {
+        return bits;
+    }
+};
+
+// sign bit flipped, negative values sort before positive ones
+template <std::signed_integral T>
+struct ordered_bits<T> {
+    using type = std::make_unsigned_t<T>;
+    static constexpr type sign_bit{type{1} << (sizeof(T) * 8 - 1)};
+
+    static constexpr auto to(T const value) noexcept -> type
+    {
+        return static_cast<type>(std::bit_cast<type>(value) ^ sign_bit);
+    }
+
+    static constexpr auto from(type const bits) noexcept -> T
+    {
+        return std::bit_cast<T>(static_cast<type>(bits ^ sign_bit));
+    }
+};
+
+// IEEE-754 total order: positive values get the sign bit set, negative
+// values have all bits inverted
+template <std::floating_point T>
+    requires(sizeof(T) == sizeof(uint32_t) || sizeof(T) == sizeof(uint64_t))
+struct ordered_bits<T> {
+    using type = std::
+        conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t>;
+    static constexpr type sign_bit{type{1} << (sizeof(T) * 8 - 1)};
+
+    static constexpr auto to(T const value) noexcept -> type
+    {
+        auto const bits = std::bit_cast<type>(value);
+        return (bits & sign_bit) != 0 ? static_cast<type>(~bits)
+                                      : bits | sign_bit;
+    }
+
+    static constexpr auto from(type const bits) noexcept -> T
+    {
+        return std::bit_cast<T>(
+            (bits & sign_bit) != 0 ? bits ^ sign_bit
+                                   : static_cast<type>(~bits));
+    }
+};
+
+// ordered bits in big-endian
+template <typename T>
+    requires requires { typename ordered_bits<T>::type; }
+struct ordered_codec<T> {
+    using bits_type = typename ordered_bits<T>::type;
+
+    static auto encode_fixed(T const value, std::byte const mask) noexcept
+        -> std::array<std::byte, sizeof(T)>
+    {
+        auto bits = ordered_bits<T>::to(value);
+        if constexpr (std::endian::native == std::endian::little)
+            bits = std::byteswap(bits);
+
+        std::array<std::byte, sizeof(T)> bytes{};
+        std::memcpy(bytes.data(), &bits, sizeof(T));
+        for (auto &byte : bytes)
+            byte ^= mask;
+        return bytes;
+    }
+
+    static auto encode(
+        T const value, std::vector<std::byte> &bytes, std::byte const mask)
+        -> void
+    {
+        auto const fixed = encode_fixed(value, mask);
+        bytes.insert(bytes.end(), fixed.begin(), fixed.end());
+    }
+
+    static auto decode(std::span<std::byte const> &bytes, std::byte const mask)
+        -> T
+    {
+        bits_type bits{};
+        std::memcpy(&bits, bytes.data(), sizeof(T));
+        bytes = bytes.subspan(sizeof(T));
+
+        if (mask != std::byte{})
+            bits = static_cast<bits_type>(~bits);
+        if constexpr (std::endian::native == std::endian::little)
+            bits = std::byteswap(bits);
+        return ordered_bits<T>::from(bits);
+    }
+};
+
+// 0x00 is escaped as 0x00 0xFF and the string is terminated by 0x00 0x01,
+// so a string sorts before every string it is a prefix of and components
+// following it do not take part in its comparison
+template <>
+struct ordered_codec<std::string> {
+    static constexpr std::byte escape{0x00};
+    static constexpr std::byte escaped_zero{0xFF};
+    static constexpr std::byte terminator{0x01};
+
+    static auto encode(
+        std::string const &value,
+        std::vector<std::byte> &bytes,
+        std::byte const mask) -> void
+    {
+        for (auto const c : value) {
+            auto const byte = static_cast<std::byte>(c);
+            bytes.push_back(byte ^ mask);
+            if (byte == escape)
+                bytes.push_back(escaped_zero ^ mask);
+        }
+        bytes.push_back(escape ^ mask);
+        bytes.push_back(terminator ^ mask);
+    }
+
+    static auto decode(std::span<std::byte const> &bytes, std::byte const mask)
+        -> std::string
+    {
+        std::string value;
+        size_t i = 0;
+        for (; i + 1 < bytes.size(); ++i) {
+            auto const byte = bytes[i] ^ mask;
+            if (byte == escape) {
+                if ((bytes[++i] ^ mask) == terminator)
+                    break;
+            }
+            value.push_back(static_cast<char>(byte));
+        }
+
+        bytes = bytes.subspan(i + 1);
+        return value;
+    }
+};
+
+template <typename T>
+concept ordered_encodable = requires(
+    T const &value,
+    std::vector<std::byte> &bytes,
+    std::span<std::byte const> &encoded) {
+    ordered_codec<T>::encode(value, bytes, std::byte{});
+    {
+        ordered_codec<T>::decode(encoded, std::byte{})
+    } -> std::same_as<T>;
+};
+
+}  // namespace lmdb::details
@@ -4,7 +4,11 @@
 #include "cpp_lmdb/db_item.hpp"
 #include "cpp_lmdb/dbs.hpp"
 #include "cpp_lmdb/iterators.hpp"
+#include "cpp_lmdb/map_growth.hpp"
+#include "cpp_lmdb/multi_transaction.hpp"
+#include "cpp_lmdb/stats.hpp"
 #include "cpp_lmdb/transactions.hpp"
+#include "cpp_lmdb/txn_pool.hpp"
 #include "cpp_lmdb/types.hpp"
 #include "cpp_lmdb/views.hpp"
 
@@ -20,6 +24,7 @@
 #include <concepts>
 #include <expected>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <utility>
 
@@ -30,7 +35,13 @@ enum class env_flags_t : unsigned int {
     none = 0,
     read_only = MDB_RDONLY,
     no_lock = MDB_NOLOCK,
-    //...
+    write_map = MDB_WRITEMAP,
+    map_async = MDB_MAPASYNC,
+    no_sync = MDB_NOSYNC,
+    no_meta_sync = MDB_NOMETASYNC,
+    no_read_ahead = MDB_NORDAHEAD,
+    no_tls = MDB_NOTLS,
+    no_mem_init = MDB_NOMEMINIT,
 };
 
 constexpr auto operator|(env_flags_t lhs, env_flags_t rhs) -> env_flags_t
@@ -49,6 +60,32 @@ constexpr auto is_readonly(env_flags_t const flags) -> read_only_t
         (flags & env_flags_t::read_only) == env_flags_t::read_only};
 }
 
+constexpr auto has_flags(env_flags_t const flags, env_flags_t const mask)
+    -> bool
+{
+    return (flags & mask) == mask;
+}
+
+// flags that only affect write transactions
+inline constexpr env_flags_t write_only_env_flags
+    = env_flags_t::write_map | env_flags_t::map_async | env_flags_t::no_sync
+      | env_flags_t::no_meta_sync | env_flags_t::no_mem_init;
+
+constexpr auto are_valid_env_flags(env_flags_t const flags) -> bool
+{
+    if (is_readonly(flags) == read_only_t::yes)
+        return (flags & write_only_env_flags) == env_flags_t::none;
+
+    return !has_flags(flags, env_flags_t::map_async)
+           || has_flags(flags, env_flags_t::write_map);
+}
+
+struct env_options_t {
+    // zero keeps LMDB default value
+    size_t map_size{};
+    unsigned int max_readers{};
+};
+
 enum class create_if_not_exists { no, yes };
 
 namespace details
@@ -81,7 +118,8 @@ protected:
         -> open_db_result<KeyValueTrait, ReadOnly>
     {
         auto &api = _env.get_deleter().api;
-        auto transaction = make_tx(api, *_env, ReadOnly);
+        auto transaction
+            = make_tx(api, *_env, ReadOnly, nullptr, _resize_guard.get());
         if (!transaction)
             return std::unexpected{error_t{transaction.error()}};
 
@@ -113,11 +151,54 @@ protected:
             return std::unexpected{error_t{result.error()}};
 
         return typename open_db_result<KeyValueTrait, ReadOnly>::value_type{
-            api, db_index, *_env};
+            api, db_index, *_env, _growth_policy, _resize_guard.get()};
+    }
+
+    template <read_only_t ReadOnly, key_value_trait... KeyValueTraits>
+    auto make_multi_transaction(
+        typename multi_transaction<ReadOnly, LmdbApiType, KeyValueTraits...>::
+            db_indices_t const &db_indices) const
+        -> std::expected<
+            multi_transaction<ReadOnly, LmdbApiType, KeyValueTraits...>,
+            error_t>
+    {
+        auto txn = make_tx(
+            _env.get_deleter().api,
+            *_env,
+            ReadOnly,
+            nullptr,
+            _resize_guard.get());
+        if (!txn)
+            return std::unexpected{error_t{txn.error()}};
+
+        return multi_transaction<ReadOnly, LmdbApiType, KeyValueTraits...>{
+            std::move(txn.value()), db_indices};
+    }
+
+    auto make_ro_txn_pool(size_t const capacity) const
+        -> ro_txn_pool<LmdbApiType>
+    {
+        return ro_txn_pool<LmdbApiType>{
+            _env.get_deleter().api, *_env, capacity, _resize_guard.get()};
+    }
+
+    auto stats() const -> std::expected<db_stats_t, error_t>
+    {
+        return details::env_stats(_env.get_deleter().api, *_env);
     }
 
+    auto info() const -> std::expected<env_info_t, error_t>
+    {
+        return details::env_info(_env.get_deleter().api, *_env);
+    }
+
+    std::optional<map_growth_policy_t> _growth_policy;
+
 private:
     details::env_unique_ptr_t<LmdbApi> _env;
+    // shared by the dbs and transactions of the environment
+    std::unique_ptr<details::map_resize_guard> _resize_guard{
+        std::make_unique<details::map_resize_guard>()};
 };
 
 }  // namespace details
@@ -132,6 +213,41 @@ public:
 
     using base::base;
 
+    // transactions acquired from the pool must not outlive it
+    auto make_ro_txn_pool(size_t const capacity) const
+        -> ro_txn_pool<std::remove_reference_t<LmdbApi>>
+    {
+        return base::make_ro_txn_pool(capacity);
+    }
+
+    // statistics of the main db, which holds the names of the named dbs
+    auto stats() const -> std::expected<db_stats_t, error_t>
+    {
+        return base::stats();
+    }
+
+    // map size and usage, last txn id and reader slots
+    auto info() const -> std::expected<env_info_t, error_t>
+    {
+        return base::info();
+    }
+
+    // consistent snapshot across several dbs of the environment
+    template <key_value_trait... KeyValueTraits>
+    auto begin_ro_transaction(ro_db<KeyValueTraits> const &...dbs) const
+        -> std::expected<
+            multi_transaction<
+                read_only_t::yes,
+                std::remove_reference_t<LmdbApi>,
+                KeyValueTraits...>,
+            error_t>
+        requires(sizeof...(KeyValueTraits) > 0)
+    {
+        return base::template make_multi_transaction<
+            read_only_t::yes,
+            KeyValueTraits...>({dbs.db_index()...});
+    }
+
     template <key_value_trait KeyValueTrait>
     auto open_ro_db(char const *const name) const noexcept
         -> std::expected<ro_db<KeyValueTrait>, error_t>
@@ -151,6 +267,13 @@ public:
 
     using base::base;
 
+    // applies to dbs opened after the call
+    auto set_map_growth_policy(
+        std::optional<map_growth_policy_t> const &growth_policy) noexcept
+    {
+        base::_growth_policy = growth_policy;
+    }
+
     template <key_value_trait KeyValueTrait>
     auto open_rw_db(
         char const *const name,
@@ -161,6 +284,33 @@ public:
         return base::template open_db<KeyValueTrait, read_only_t::no>(
             name, create_flag);
     }
+
+    // single write transaction spanning several dbs of the environment
+    template <key_value_trait... KeyValueTraits>
+    auto begin_rw_transaction(rw_db<KeyValueTraits> &...dbs)
+        -> std::expected<
+            multi_transaction<
+                read_only_t::no,
+                std::remove_reference_t<LmdbApi>,
+                KeyValueTraits...>,
+            error_t>
+        requires(sizeof...(KeyValueTraits) > 0)
+    {
+        return base::template make_multi_transaction<
+            read_only_t::no,
+            KeyValueTraits...>({dbs.db_index()...});
+    }
+
+    template <key_value_trait... KeyValueTraits>
+    auto commit_transaction(
+        multi_transaction<
+            read_only_t::no,
+            std::remove_reference_t<LmdbApi>,
+            KeyValueTraits...> &&transaction)
+        -> std::expected<void, error_t>
+    {
+        return std::move(transaction).commit();
+    }
 };
 
 template <read_only_t ReadOnly, lmdb_api_like LmdbApi>
@@ -179,8 +329,10 @@ template <
 auto make_environment(
     char const *const environment_path,
     db_file_mode_t const db_file_mode,
+    env_options_t const &options,
     LmdbApi &&api = LmdbApi{})
     LMDB_NOEXCEPT->LMDB_RESULT((environment_t<is_readonly(flags), LmdbApi>))
+    requires(are_valid_env_flags(flags))
 {
     MDB_env *env{nullptr};
     LMDB_CALL_API(api.mdb_env_create(&env));
@@ -189,6 +341,14 @@ auto make_environment(
         env, details::env_deleter<LmdbApi>{std::forward<LmdbApi>(api)}};
     LMDB_CALL_API(api.mdb_env_set_maxdbs(env_ptr.get(), max_db_count));
 
+    if (options.map_size != 0)
+        LMDB_CALL_API(
+            api.mdb_env_set_mapsize(env_ptr.get(), options.map_size));
+
+    if (options.max_readers != 0)
+        LMDB_CALL_API(
+            api.mdb_env_set_maxreaders(env_ptr.get(), options.max_readers));
+
     LMDB_CALL_API(api.mdb_env_open(
         env_ptr.get(),
         environment_path,
@@ -198,4 +358,22 @@ auto make_environment(
     return environment_t<is_readonly(flags), LmdbApi>{std::move(env_ptr)};
 }
 
+template <
+    env_flags_t flags,
+    size_t max_db_count,
+    lmdb_api_like LmdbApi = details::api>
+auto make_environment(
+    char const *const environment_path,
+    db_file_mode_t const db_file_mode,
+    LmdbApi &&api = LmdbApi{})
+    LMDB_NOEXCEPT->LMDB_RESULT((environment_t<is_readonly(flags), LmdbApi>))
+    requires(are_valid_env_flags(flags))
+{
+    return make_environment<flags, max_db_count>(
+        environment_path,
+        db_file_mode,
+        env_options_t{},
+        std::forward<LmdbApi>(api));
+}
+
 }  // namespace lmdb
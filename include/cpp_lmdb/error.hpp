@@ -3,6 +3,7 @@
 #include "lmdb.h"
 
 // std
+#include <cerrno>
 #include <exception>
 #include <expected>
 
@@ -30,6 +31,8 @@ enum class error_t : int {
     bad_txn = MDB_BAD_TXN,
     bad_valsize = MDB_BAD_VALSIZE,
     bad_dbi = MDB_BAD_DBI,
+    // also reported by LMDB itself for invalid parameters
+    invalid_argument = EINVAL,
 };
 
 #ifdef CPP_LMDB_EXCEPTIONS_ENABLED
@@ -0,0 +1,92 @@
+#pragma once
+
+// std
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace lmdb
+{
+
+template <typename Executor>
+concept executor_like
+    = requires(Executor &executor, std::function<void()> work) {
+          executor.execute(std::move(work));
+      };
+
+// Fixed size pool of worker threads running submitted work in FIFO order.
+// Work still queued when the pool is destroyed is run before the workers
+// are joined.
+class thread_pool_executor {
+public:
+    explicit thread_pool_executor(size_t const thread_count)
+    {
+        _workers.reserve(thread_count);
+        for (size_t i = 0; i < thread_count; ++i) {
+            _workers.emplace_back(
+                [this](std::stop_token const &stop) { run(stop); });
+        }
+    }
+
+    thread_pool_executor(thread_pool_executor const &) = delete;
+    auto operator=(thread_pool_executor const &)
+        -> thread_pool_executor & = delete;
+
+    ~thread_pool_executor()
+    {
+        for (auto &worker : _workers)
+            worker.request_stop();
+        _work_available.notify_all();
+    }
+
+    auto execute(std::function<void()> work) -> void
+    {
+        {
+            std::lock_guard const lock{_mutex};
+            _queue.push_back(std::move(work));
+        }
+        _work_available.notify_one();
+    }
+
+private:
+    auto run(std::stop_token const &stop) -> void
+    {
+        while (true) {
+            std::function<void()> work;
+            {
+                std::unique_lock lock{_mutex};
+                if (!_work_available.wait(
+                        lock, stop, [this] { return !_queue.empty(); }))
+                    return;
+
+                work = std::move(_queue.front());
+                _queue.pop_front();
+            }
+
+            work();
+        }
+    }
+
+    std::mutex _mutex;
+    std::condition_variable_any _work_available;
+    std::deque<std::function<void()>> _queue;
+
+    // declared last to join the workers before other members are destroyed
+    std::vector<std::jthread> _workers;
+};
+
+inline constexpr size_t default_executor_thread_count{4};
+
+inline auto default_executor() -> thread_pool_executor &
+{
+    static thread_pool_executor executor{default_executor_thread_count};
+    return executor;
+}
+
+}  // namespace lmdb
@@ -0,0 +1,422 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/dbs.hpp"
+#include "cpp_lmdb/environment.hpp"
+#include "cpp_lmdb/error.hpp"
+#include "cpp_lmdb/multi_transaction.hpp"
+#include "cpp_lmdb/types.hpp"
+
+// details
+#include "cpp_lmdb/details/key_value_traits.hpp"
+
+// std
+#include <algorithm>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lmdb
+{
+
+// Secondary index of an indexed_table: Extractor (a function, a captureless
+// lambda or a pointer to member) maps a record to its index key, encoded by
+// KeyTrait.
+template <key_trait KeyTrait, auto Extractor>
+struct secondary_index {
+    using key_trait = KeyTrait;
+    using key_type = typename KeyTrait::value_type;
+
+    template <typename Value>
+    static auto extract(Value const &value) -> key_type
+    {
+        return std::invoke(Extractor, value);
+    }
+};
+
+namespace details
+{
+// index keys map to the primary keys of the records, sorted as duplicates
+template <typename Index, key_value_trait PrimaryTrait>
+using index_db_trait = duplicate_key<
+    typename Index::key_trait,
+    typename PrimaryTrait::key_trait>;
+
+template <typename Trait>
+auto same_bytes(
+    typename Trait::value_type const &lhs,
+    typename Trait::value_type const &rhs) -> bool
+{
+    auto const lhs_bytes = Trait::to_bytes(lhs);
+    auto const rhs_bytes = Trait::to_bytes(rhs);
+    return std::ranges::equal(
+        std::span{lhs_bytes.data(), lhs_bytes.size()},
+        std::span{rhs_bytes.data(), rhs_bytes.size()});
+}
+}  // namespace details
+
+template <
+    lmdb_api_like LmdbApi,
+    key_value_trait PrimaryTrait,
+    typename... Indices>
+class indexed_table;
+
+// Transaction over the primary db of an indexed_table and its index dbs,
+// all in one MDB_txn. Writes keep the indices up to date; lookups through
+// an index collect the primary keys first and resolve them with get_many,
+// i.e. one cursor walk over the primary db in key order.
+template <
+    read_only_t ReadOnly,
+    lmdb_api_like LmdbApi,
+    key_value_trait PrimaryTrait,
+    typename... Indices>
+class indexed_transaction {
+    template <lmdb_api_like, key_value_trait, typename...>
+    friend class indexed_table;
+
+    using multi_transaction_type = multi_transaction<
+        ReadOnly,
+        LmdbApi,
+        PrimaryTrait,
+        details::index_db_trait<Indices, PrimaryTrait>...>;
+
+    using indices = std::tuple<Indices...>;
+
+public:
+    using key_type = typename PrimaryTrait::key_trait::value_type;
+    using value_type = typename PrimaryTrait::value_trait::value_type;
+    using record_type = std::pair<key_type, value_type>;
+
+    template <size_t Index>
+    using index_key_type =
+        typename std::tuple_element_t<Index, indices>::key_type;
+
+public:
+    explicit indexed_transaction(multi_transaction_type &&txn) noexcept
+        : _txn{std::move(txn)}
+    {}
+
+    auto get(key_type const &key) const -> std::expected<value_type, error_t>
+    {
+        return primary().get(key);
+    }
+
+    // inserts or overwrites the record, the index entries of an overwritten
+    // record are moved to its new index keys
+    auto insert(key_type const &key, value_type const &value)
+        -> std::expected<void, error_t>
+        requires(ReadOnly == read_only_t::no)
+    {
+        auto const previous = primary().get(key);
+        if (!previous && previous.error() != error_t::not_found)
+            return std::unexpected{previous.error()};
+
+        if (auto const result = primary().insert(key, value); !result)
+            return result;
+
+        return update_indices(
+            key,
+            previous ? &*previous : nullptr,
+            &value,
+            std::index_sequence_for<Indices...>{});
+    }
+
+    auto delete_key(key_type const &key) -> std::expected<void, error_t>
+        requires(ReadOnly == read_only_t::no)
+    {
+        auto const previous = primary().get(key);
+        if (!previous)
+            return std::unexpected{previous.error()};
+
+        if (auto const result = primary().delete_key(key); !result)
+            return result;
+
+        return update_indices(
+            key, &*previous, nullptr, std::index_sequence_for<Indices...>{});
+    }
+
+    // records whose index key of the Index-th index is key, in primary key
+    // order
+    template <size_t Index>
+    auto find(index_key_type<Index> const &key) const
+        -> std::expected<std::vector<record_type>, error_t>
+    {
+        auto const view = index<Index>().iterate_by_key(key);
+        if (!view)
+            return std::unexpected{view.error()};
+
+        std::vector<key_type> keys;
+        for (auto const &item : *view)
+            keys.push_back(item.value());
+        return resolve(std::move(keys));
+    }
+
+    // records whose index key of the Index-th index is in [lower, upper),
+    // in index key order
+    template <size_t Index>
+    auto find_range(
+        index_key_type<Index> const &lower,
+        index_key_type<Index> const &upper) const
+        -> std::expected<std::vector<record_type>, error_t>
+    {
+        auto const view = index<Index>().iterate_range(lower, upper);
+        if (!view)
+            return std::unexpected{view.error()};
+
+        std::vector<key_type> keys;
+        for (auto const &item : *view)
+            keys.push_back(item.value());
+        return resolve(std::move(keys));
+    }
+
+    // the underlying accessors, writing through them bypasses the indices
+    auto primary() noexcept -> auto &
+    {
+        return _txn.template db<0>();
+    }
+
+    auto primary() const noexcept -> auto const &
+    {
+        return _txn.template db<0>();
+    }
+
+    template <size_t Index>
+    auto index() noexcept -> auto &
+    {
+        return _txn.template db<Index + 1>();
+    }
+
+    template <size_t Index>
+    auto index() const noexcept -> auto const &
+    {
+        return _txn.template db<Index + 1>();
+    }
+
+private:
+    template <size_t... Index>
+    auto update_indices(
+        key_type const &key,
+        value_type const *const previous,
+        value_type const *const current,
+        std::index_sequence<Index...>) -> std::expected<void, error_t>
+    {
+        std::expected<void, error_t> result;
+        (void)((result = update_index<Index>(key, previous, current))
+               && ...);
+        return result;
+    }
+
+    template <size_t Index>
+    auto update_index(
+        key_type const &key,
+        value_type const *const previous,
+        value_type const *const current) -> std::expected<void, error_t>
+    {
+        using index_type = std::tuple_element_t<Index, indices>;
+        using index_key_trait = typename index_type::key_trait;
+
+        std::optional<index_key_type<Index>> previous_key;
+        std::optional<index_key_type<Index>> current_key;
+        if (previous)
+            previous_key = index_type::extract(*previous);
+        if (current)
+            current_key = index_type::extract(*current);
+
+        if (previous_key && current_key
+            && details::same_bytes<index_key_trait>(
+                *previous_key, *current_key))
+            return {};
+
+        if (previous_key) {
+            if (auto const result
+                = index<Index>().delete_duplicate(*previous_key, key);
+                !result)
+                return result;
+        }
+        if (current_key)
+            return index<Index>().insert(*current_key, key);
+        return {};
+    }
+
+    auto resolve(std::vector<key_type> keys) const
+        -> std::expected<std::vector<record_type>, error_t>
+    {
+        std::vector<std::expected<value_type, error_t>> values(keys.size());
+        if (auto const result = primary().get_many(keys, values); !result)
+            return std::unexpected{result.error()};
+
+        std::vector<record_type> records;
+        records.reserve(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (!values[i])
+                return std::unexpected{values[i].error()};
+            records.emplace_back(std::move(keys[i]), std::move(*values[i]));
+        }
+        return records;
+    }
+
+    multi_transaction_type _txn;
+};
+
+// A primary unique_key db plus one duplicate_key index db per Indices
+// entry, named "<name>#<position of the index>". Requires an environment
+// with room for 1 + sizeof...(Indices) named dbs; the table keeps a
+// reference to it.
+template <
+    lmdb_api_like LmdbApi,
+    key_value_trait PrimaryTrait,
+    typename... Indices>
+class indexed_table {
+    using api_type = std::remove_reference_t<LmdbApi>;
+
+    template <typename KeyValueTrait>
+    using db_type = rw_db<KeyValueTrait, api_type>;
+
+public:
+    using rw_transaction = indexed_transaction<
+        read_only_t::no,
+        api_type,
+        PrimaryTrait,
+        Indices...>;
+    using ro_transaction = indexed_transaction<
+        read_only_t::yes,
+        api_type,
+        PrimaryTrait,
+        Indices...>;
+
+public:
+    static auto open(
+        rw_environment<LmdbApi> &env,
+        std::string const &name,
+        create_if_not_exists const create_flag = create_if_not_exists::no)
+        -> std::expected<indexed_table, error_t>
+        requires(!details::key_value_trait_helper<
+                 PrimaryTrait>::duplicates_enabled)
+    {
+        auto primary = env.template open_rw_db<PrimaryTrait>(
+            name.c_str(), create_flag);
+        if (!primary)
+            return std::unexpected{primary.error()};
+
+        auto indices = open_indices(
+            env, name, create_flag, std::index_sequence_for<Indices...>{});
+        if (!indices)
+            return std::unexpected{indices.error()};
+
+        return indexed_table{env, std::move(*primary), std::move(*indices)};
+    }
+
+    auto begin_rw_transaction() -> std::expected<rw_transaction, error_t>
+    {
+        auto txn = std::apply(
+            [this](auto &...indices) {
+                return _env.begin_rw_transaction(_primary, indices...);
+            },
+            _indices);
+        if (!txn)
+            return std::unexpected{txn.error()};
+
+        return rw_transaction{std::move(*txn)};
+    }
+
+    auto begin_ro_transaction() const -> std::expected<ro_transaction, error_t>
+    {
+        auto txn = std::apply(
+            [this](auto const &...indices) {
+                return _env.begin_ro_transaction(_primary, indices...);
+            },
+            _indices);
+        if (!txn)
+            return std::unexpected{txn.error()};
+
+        return ro_transaction{std::move(*txn)};
+    }
+
+    auto commit_transaction(rw_transaction &&transaction)
+        -> std::expected<void, error_t>
+    {
+        return _env.commit_transaction(std::move(transaction._txn));
+    }
+
+private:
+    using indices_type = std::tuple<
+        db_type<details::index_db_trait<Indices, PrimaryTrait>>...>;
+
+    indexed_table(
+        rw_environment<LmdbApi> &env,
+        db_type<PrimaryTrait> &&primary,
+        indices_type &&indices)
+        : _env{env}
+        , _primary{std::move(primary)}
+        , _indices{std::move(indices)}
+    {}
+
+    template <size_t... Index>
+    static auto open_indices(
+        rw_environment<LmdbApi> &env,
+        std::string const &name,
+        create_if_not_exists const create_flag,
+        std::index_sequence<Index...>)
+        -> std::expected<indices_type, error_t>
+    {
+        std::optional<error_t> error;
+        auto const open_index =
+            [&]<size_t I>(std::integral_constant<size_t, I>)
+            -> std::optional<std::tuple_element_t<I, indices_type>> {
+            using index_trait = details::index_db_trait<
+                std::tuple_element_t<I, std::tuple<Indices...>>,
+                PrimaryTrait>;
+            if (error)
+                return std::nullopt;
+
+            auto const index_name = name + "#" + std::to_string(I);
+            auto db = env.template open_rw_db<index_trait>(
+                index_name.c_str(), create_flag);
+            if (!db) {
+                error = db.error();
+                return std::nullopt;
+            }
+            return std::move(*db);
+        };
+
+        // opened in index order, the first failure skips the others
+        std::tuple opened{
+            open_index(std::integral_constant<size_t, Index>{})...};
+        if (error)
+            return std::unexpected{*error};
+
+        return indices_type{std::move(*std::get<Index>(opened))...};
+    }
+
+    rw_environment<LmdbApi> &_env;
+    db_type<PrimaryTrait> _primary;
+    indices_type _indices;
+};
+
+// Opens the indexed_table of PrimaryTrait records named name in env, e.g.
+// open_indexed_table<order_trait, secondary_index<string_trait,
+// &order::customer>>(env, "orders", create_if_not_exists::yes).
+template <
+    key_value_trait PrimaryTrait,
+    typename... Indices,
+    lmdb_api_like LmdbApi>
+auto open_indexed_table(
+    rw_environment<LmdbApi> &env,
+    std::string const &name,
+    create_if_not_exists const create_flag = create_if_not_exists::no)
+    -> std::expected<
+        indexed_table<LmdbApi, PrimaryTrait, Indices...>,
+        error_t>
+{
+    return indexed_table<LmdbApi, PrimaryTrait, Indices...>::open(
+        env, name, create_flag);
+}
+
+}  // namespace lmdb
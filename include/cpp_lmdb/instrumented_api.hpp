@@ -0,0 +1,469 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/error.hpp"
+
+// details
+#include "cpp_lmdb/details/api.hpp"
+
+// lmdb
+#include "lmdb.h"
+
+// std
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lmdb
+{
+// calls timed by instrumented_api; begin of write transactions includes
+// the wait for the writer lock, commit includes the sync to disk
+enum class api_operation : size_t {
+    ro_txn_begin,
+    rw_txn_begin,
+    txn_renew,
+    txn_commit,
+    get,
+    put,
+    del,
+    cursor_get,
+    cursor_put,
+};
+
+inline constexpr size_t api_operation_count{9};
+
+constexpr auto to_string(api_operation const operation) noexcept
+    -> std::string_view
+{
+    constexpr std::array<std::string_view, api_operation_count> names{
+        "mdb_txn_begin(ro)",
+        "mdb_txn_begin(rw)",
+        "mdb_txn_renew",
+        "mdb_txn_commit",
+        "mdb_get",
+        "mdb_put",
+        "mdb_del",
+        "mdb_cursor_get",
+        "mdb_cursor_put",
+    };
+    return names[std::to_underlying(operation)];
+}
+
+// Slots of the result counts: success, one per error_t, then any other
+// code (errno values such as EINVAL or ENOMEM).
+inline constexpr size_t result_slot_count{
+    2 + static_cast<size_t>(MDB_LAST_ERRCODE - MDB_KEYEXIST + 1)};
+
+constexpr auto result_slot(int const result) noexcept -> size_t
+{
+    if (result == MDB_SUCCESS)
+        return 0;
+    if (result >= MDB_KEYEXIST && result <= MDB_LAST_ERRCODE)
+        return static_cast<size_t>(result - MDB_KEYEXIST) + 1;
+    return result_slot_count - 1;
+}
+
+// Log-linear histogram of latencies in nanoseconds, in the manner of HDR
+// histograms: values below 16 have a bucket each, larger values 16 buckets
+// per power of two, i.e. a relative error below 1/16. Values of 2^40 ns
+// (about 18 minutes) and more share the last bucket.
+class latency_histogram {
+public:
+    static constexpr unsigned sub_bucket_bits{4};
+    static constexpr size_t sub_bucket_count{size_t{1} << sub_bucket_bits};
+    static constexpr unsigned max_exponent{39};
+    static constexpr size_t bucket_count{
+        sub_bucket_count * (max_exponent - sub_bucket_bits + 2)};
+
+    static constexpr auto bucket_of(uint64_t const nanoseconds) noexcept
+        -> size_t
+    {
+        if (nanoseconds < sub_bucket_count)
+            return static_cast<size_t>(nanoseconds);
+
+        auto const exponent
+            = static_cast<unsigned>(std::bit_width(nanoseconds)) - 1;
+        if (exponent > max_exponent)
+            return bucket_count - 1;
+
+        auto const sub_bucket = (nanoseconds >> (exponent - sub_bucket_bits))
+                                & (sub_bucket_count - 1);
+        return sub_bucket_count * (exponent - sub_bucket_bits + 1)
+               + static_cast<size_t>(sub_bucket);
+    }
+
+    // smallest value recorded in bucket
+    static constexpr auto lower_bound(size_t const bucket) noexcept
+        -> uint64_t
+    {
+        if (bucket < sub_bucket_count)
+            return bucket;
+
+        auto const exponent = static_cast<unsigned>(
+            bucket / sub_bucket_count + sub_bucket_bits - 1);
+        auto const sub_bucket = bucket % sub_bucket_count;
+        return (sub_bucket_count + sub_bucket)
+               << (exponent - sub_bucket_bits);
+    }
+
+    auto record(uint64_t const nanoseconds, uint64_t const count = 1) noexcept
+        -> void
+    {
+        _counts[bucket_of(nanoseconds)] += count;
+        _total += count;
+    }
+
+    auto count() const noexcept -> uint64_t
+    {
+        return _total;
+    }
+
+    // from the middle of the buckets
+    auto mean() const noexcept -> double
+    {
+        if (_total == 0)
+            return 0.0;
+
+        double sum{};
+        for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+            if (_counts[bucket] == 0)
+                continue;
+            auto const middle
+                = (static_cast<double>(lower_bound(bucket))
+                   + static_cast<double>(upper_bound(bucket)))
+                  / 2;
+            sum += middle * static_cast<double>(_counts[bucket]);
+        }
+        return sum / static_cast<double>(_total);
+    }
+
+    // highest value of the bucket holding the given percentile, 0 when
+    // empty
+    auto percentile(double const percent) const noexcept -> uint64_t
+    {
+        if (_total == 0)
+            return 0;
+
+        auto const rank = std::max<uint64_t>(
+            1,
+            static_cast<uint64_t>(std::ceil(
+                std::clamp(percent, 0.0, 100.0) / 100.0
+                * static_cast<double>(_total))));
+        uint64_t seen{};
+        for (size_t bucket = 0; bucket < bucket_count; ++bucket) {
+            seen += _counts[bucket];
+            if (seen >= rank)
+                return upper_bound(bucket);
+        }
+        return upper_bound(bucket_count - 1);
+    }
+
+    auto buckets() const noexcept -> std::span<uint64_t const, bucket_count>
+    {
+        return _counts;
+    }
+
+    auto operator+=(latency_histogram const &other) noexcept
+        -> latency_histogram &
+    {
+        for (size_t bucket = 0; bucket < bucket_count; ++bucket)
+            _counts[bucket] += other._counts[bucket];
+        _total += other._total;
+        return *this;
+    }
+
+    // the values recorded since earlier, a snapshot of the same histogram
+    auto operator-=(latency_histogram const &earlier) noexcept
+        -> latency_histogram &
+    {
+        for (size_t bucket = 0; bucket < bucket_count; ++bucket)
+            _counts[bucket] -= earlier._counts[bucket];
+        _total -= earlier._total;
+        return *this;
+    }
+
+private:
+    static constexpr auto upper_bound(size_t const bucket) noexcept
+        -> uint64_t
+    {
+        return bucket + 1 < bucket_count
+                   ? lower_bound(bucket + 1) - 1
+                   : lower_bound(bucket) * 2 - 1;
+    }
+
+    std::array<uint64_t, bucket_count> _counts{};
+    uint64_t _total{};
+};
+
+struct api_operation_stats_t {
+    latency_histogram latency;
+    // see result_slot
+    std::array<uint64_t, result_slot_count> results{};
+
+    auto calls() const noexcept -> uint64_t
+    {
+        return latency.count();
+    }
+
+    auto errors(error_t const error) const noexcept -> uint64_t
+    {
+        return results[result_slot(std::to_underlying(error))];
+    }
+};
+
+struct api_stats_t {
+    std::array<api_operation_stats_t, api_operation_count> operations{};
+
+    auto operator[](api_operation const operation) const noexcept
+        -> api_operation_stats_t const &
+    {
+        return operations[std::to_underlying(operation)];
+    }
+
+    // the calls made since earlier, e.g. to export intervals
+    auto since(api_stats_t const &earlier) const noexcept -> api_stats_t
+    {
+        auto delta = *this;
+        for (size_t op = 0; op < api_operation_count; ++op) {
+            delta.operations[op].latency -= earlier.operations[op].latency;
+            for (size_t slot = 0; slot < result_slot_count; ++slot) {
+                delta.operations[op].results[slot]
+                    -= earlier.operations[op].results[slot];
+            }
+        }
+        return delta;
+    }
+};
+
+// Decorator of an lmdb_api_like Inner timing the calls listed in
+// api_operation and counting their results; the other calls are forwarded
+// as they are. Each thread records into counters of its own, written
+// without locks or read-modify-write instructions; snapshot() sums them
+// while the calls go on. A thread looks its counters up under a lock only
+// when it starts using another instrumented_api.
+//
+// The decorator holds its counters, so it is passed to make_environment
+// as an lvalue and must outlive the environment:
+//
+//     lmdb::instrumented_api<> api;
+//     auto env = lmdb::make_environment<flags, 4>(path, mode, api);
+//
+// Inner may be a reference, e.g. to a mock.
+template <typename Inner = details::api>
+    requires lmdb_api_like<std::remove_reference_t<Inner>>
+class instrumented_api {
+    using clock = std::chrono::steady_clock;
+
+public:
+    instrumented_api()
+        requires std::is_default_constructible_v<Inner>
+    = default;
+
+    explicit instrumented_api(Inner inner)
+        : _inner{std::forward<Inner>(inner)}
+    {}
+
+    instrumented_api(instrumented_api const &) = delete;
+    auto operator=(instrumented_api const &) -> instrumented_api & = delete;
+
+    // sums the counters of all threads; calls racing the snapshot are
+    // either fully or partly counted
+    auto snapshot() const -> api_stats_t
+    {
+        api_stats_t stats;
+        std::lock_guard const lock{_mutex};
+        for (auto const &counters : _threads) {
+            for (size_t op = 0; op < api_operation_count; ++op) {
+                auto &target = stats.operations[op];
+                auto const &source = counters->operations[op];
+                for (size_t bucket = 0;
+                     bucket < latency_histogram::bucket_count;
+                     ++bucket) {
+                    if (auto const count = source.latency[bucket].load(
+                            std::memory_order_relaxed);
+                        count != 0) {
+                        target.latency.record(
+                            latency_histogram::lower_bound(bucket), count);
+                    }
+                }
+                for (size_t slot = 0; slot < result_slot_count; ++slot) {
+                    target.results[slot] += source.results[slot].load(
+                        std::memory_order_relaxed);
+                }
+            }
+        }
+        return stats;
+    }
+
+    auto inner() const noexcept -> std::remove_reference_t<Inner> const &
+    {
+        return _inner;
+    }
+
+    // clang-format off
+    // NOLINTBEGIN(modernize-use-trailing-return-type)
+#define CPP_LMDB_FORWARD_CALL(method)                       \
+    template <typename... T>                                \
+    decltype(auto) method(T &&...params) const              \
+    {                                                       \
+        return _inner.method(std::forward<T>(params)...);   \
+    }
+
+#define CPP_LMDB_TIMED_CALL(method, operation)              \
+    template <typename... T>                                \
+    int method(T &&...params) const                         \
+    {                                                       \
+        auto const start = clock::now();                    \
+        auto const result                                   \
+            = _inner.method(std::forward<T>(params)...);    \
+        record(api_operation::operation, start, result);    \
+        return result;                                      \
+    }
+
+    CPP_LMDB_FORWARD_CALL(mdb_env_create)
+    CPP_LMDB_FORWARD_CALL(mdb_env_close)
+    CPP_LMDB_FORWARD_CALL(mdb_env_open)
+    CPP_LMDB_FORWARD_CALL(mdb_env_set_maxdbs)
+    CPP_LMDB_FORWARD_CALL(mdb_env_set_mapsize)
+    CPP_LMDB_FORWARD_CALL(mdb_env_set_maxreaders)
+    CPP_LMDB_FORWARD_CALL(mdb_env_info)
+    CPP_LMDB_FORWARD_CALL(mdb_env_stat)
+
+    CPP_LMDB_FORWARD_CALL(mdb_txn_abort)
+    CPP_LMDB_FORWARD_CALL(mdb_txn_reset)
+    CPP_LMDB_FORWARD_CALL(mdb_txn_env)
+    CPP_LMDB_FORWARD_CALL(mdb_txn_id)
+    CPP_LMDB_TIMED_CALL(mdb_txn_renew, txn_renew)
+    CPP_LMDB_TIMED_CALL(mdb_txn_commit, txn_commit)
+
+    CPP_LMDB_FORWARD_CALL(mdb_dbi_open)
+    CPP_LMDB_FORWARD_CALL(mdb_drop)
+    CPP_LMDB_FORWARD_CALL(mdb_stat)
+    CPP_LMDB_FORWARD_CALL(mdb_set_compare)
+    CPP_LMDB_FORWARD_CALL(mdb_set_dupsort)
+    CPP_LMDB_FORWARD_CALL(mdb_cmp)
+
+    CPP_LMDB_TIMED_CALL(mdb_get, get)
+    CPP_LMDB_TIMED_CALL(mdb_put, put)
+    CPP_LMDB_TIMED_CALL(mdb_del, del)
+
+    CPP_LMDB_FORWARD_CALL(mdb_cursor_open)
+    CPP_LMDB_FORWARD_CALL(mdb_cursor_close)
+    CPP_LMDB_FORWARD_CALL(mdb_cursor_renew)
+    CPP_LMDB_TIMED_CALL(mdb_cursor_get, cursor_get)
+    CPP_LMDB_TIMED_CALL(mdb_cursor_put, cursor_put)
+
+#undef CPP_LMDB_TIMED_CALL
+#undef CPP_LMDB_FORWARD_CALL
+    // NOLINTEND(modernize-use-trailing-return-type)
+    // clang-format on
+
+    auto mdb_txn_begin(
+        MDB_env *const env,
+        MDB_txn *const parent,
+        unsigned int const flags,
+        MDB_txn **const txn) const -> int
+    {
+        auto const start = clock::now();
+        auto const result = _inner.mdb_txn_begin(env, parent, flags, txn);
+        record(
+            (flags & MDB_RDONLY) != 0 ? api_operation::ro_txn_begin
+                                      : api_operation::rw_txn_begin,
+            start,
+            result);
+        return result;
+    }
+
+private:
+    struct operation_counters {
+        std::array<std::atomic<uint64_t>, latency_histogram::bucket_count>
+            latency;
+        std::array<std::atomic<uint64_t>, result_slot_count> results;
+    };
+
+    struct thread_counters {
+        std::array<operation_counters, api_operation_count> operations;
+    };
+
+    // the counters of a thread have a single writer
+    static auto increment(std::atomic<uint64_t> &counter) noexcept -> void
+    {
+        counter.store(
+            counter.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+    }
+
+    auto record(
+        api_operation const operation,
+        clock::time_point const start,
+        int const result) const -> void
+    {
+        auto const elapsed
+            = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  clock::now() - start)
+                  .count();
+        auto &counters
+            = this_thread_counters().operations[std::to_underlying(operation)];
+        increment(counters.latency[latency_histogram::bucket_of(
+            static_cast<uint64_t>(std::max<decltype(elapsed)>(elapsed, 0)))]);
+        increment(counters.results[result_slot(result)]);
+    }
+
+    auto this_thread_counters() const -> thread_counters &
+    {
+        // the last api used by the thread, the instance id tells apart an
+        // api constructed at the address of a destroyed one
+        struct cached_counters {
+            instrumented_api const *api;
+            uint64_t instance;
+            thread_counters *counters;
+        };
+        thread_local cached_counters cached{};
+
+        if (cached.api == this && cached.instance == _instance)
+            return *cached.counters;
+
+        std::lock_guard const lock{_mutex};
+        auto const thread = std::this_thread::get_id();
+        auto const it = std::ranges::find(_thread_ids, thread);
+        thread_counters *counters{};
+        if (it == _thread_ids.end()) {
+            _thread_ids.push_back(thread);
+            counters = _threads
+                           .emplace_back(std::make_unique<thread_counters>())
+                           .get();
+        } else {
+            counters = _threads[static_cast<size_t>(
+                                    std::distance(_thread_ids.begin(), it))]
+                           .get();
+        }
+
+        cached = {this, _instance, counters};
+        return *counters;
+    }
+
+    static inline std::atomic<uint64_t> next_instance{1};
+
+    Inner _inner;
+    uint64_t const _instance{
+        next_instance.fetch_add(1, std::memory_order_relaxed)};
+
+    mutable std::mutex _mutex;
+    mutable std::vector<std::thread::id> _thread_ids;
+    mutable std::vector<std::unique_ptr<thread_counters>> _threads;
+};
+
+}  // namespace lmdb
@@ -7,9 +7,11 @@
 #include "cpp_lmdb/details/details.hpp"
 
 // std
+#include <algorithm>
 #include <expected>
 #include <iterator>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace lmdb
@@ -96,6 +98,7 @@ protected:
             result != MDB_SUCCESS) {
             _item = std::unexpected{error_t{result}};
         } else {
+            _key = mdb_key;
             _item = ro_db_item<KeyTrait, ValueTrait>{
                 to_byte_span(mdb_key), to_byte_span(mdb_value)};
         }
@@ -106,14 +109,34 @@ protected:
         return _item.has_value();
     }
 
+    // key of the current item
+    auto current_key() const noexcept -> MDB_val const &
+    {
+        return _key;
+    }
+
+    auto set_end() noexcept -> void
+    {
+        _item = std::unexpected{error_t::not_found};
+    }
+
+    auto api() const noexcept -> LmdbApi const &
+    {
+        return _api.get();
+    }
+
 private:
     std::reference_wrapper<LmdbApi const> _api;
     std::reference_wrapper<MDB_cursor> _cursor;
     std::expected<value_type, error_t> _item;
+    MDB_val _key{};
 };
 }  // namespace details
 
-template <key_trait KeyTrait, value_trait ValueTrait, lmdb_api_like LmdbApi>
+template <
+    deserialization_trait KeyTrait,
+    deserialization_trait ValueTrait,
+    lmdb_api_like LmdbApi>
 class ro_iterator
     : public details::
           ro_iterator_base<ro_iterator, KeyTrait, ValueTrait, LmdbApi> {
@@ -146,7 +169,10 @@ private:
     }
 };
 
-template <key_trait KeyTrait, value_trait ValueTrait, lmdb_api_like LmdbApi>
+template <
+    deserialization_trait KeyTrait,
+    deserialization_trait ValueTrait,
+    lmdb_api_like LmdbApi>
 class ro_dup_iterator
     : public details::
           ro_iterator_base<ro_dup_iterator, KeyTrait, ValueTrait, LmdbApi> {
@@ -159,7 +185,7 @@ public:
         LmdbApi const &api, MDB_cursor &cursor, byte_span const &key) noexcept
         : base{api, cursor}, _key{details::to_mdb_val(key)}
     {
-        base::navigate_cursor(MDB_FIRST_DUP, &_key);
+        base::navigate_cursor(MDB_SET_KEY, &_key);
     }
 
     ro_dup_iterator(ro_dup_iterator &&) = default;
@@ -182,4 +208,348 @@ private:
     MDB_val _key;
 };
 
+enum class direction_t : bool { forward, reverse };
+
+namespace details
+{
+// Key range of a cursor walk in the order of the db comparator: the walk
+// covers [lower, upper), an absent bound is unbounded. A forward walk also
+// stops at the first key whose bytes do not start with prefix.
+struct cursor_range {
+    MDB_txn *txn;
+    MDB_dbi dbi;
+    direction_t direction;
+    bool duplicates_enabled;
+    std::optional<std::vector<std::byte>> lower;
+    std::optional<std::vector<std::byte>> upper;
+    std::optional<std::vector<std::byte>> prefix{};
+};
+}  // namespace details
+
+// Iterator over a key range, forward (MDB_SET_RANGE, MDB_NEXT) or reverse
+// (MDB_LAST, MDB_PREV), that can be repositioned with seek.
+template <
+    deserialization_trait KeyTrait,
+    deserialization_trait ValueTrait,
+    lmdb_api_like LmdbApi>
+class ro_range_iterator
+    : public details::
+          ro_iterator_base<ro_range_iterator, KeyTrait, ValueTrait, LmdbApi> {
+private:
+    using base = details::
+        ro_iterator_base<ro_range_iterator, KeyTrait, ValueTrait, LmdbApi>;
+
+    friend base;
+
+public:
+    explicit ro_range_iterator(
+        LmdbApi const &api,
+        MDB_cursor &cursor,
+        details::cursor_range const &range) noexcept
+        : base{api, cursor}, _range{range}
+    {
+        if (is_forward()) {
+            auto const lower = to_mdb_val(range.lower);
+            position_at_or_after(lower ? &*lower : nullptr);
+        } else {
+            auto const upper = to_mdb_val(range.upper);
+            position_before(upper ? &*upper : nullptr, false);
+        }
+    }
+
+    ro_range_iterator(ro_range_iterator &&) = default;
+    auto operator=(ro_range_iterator &&) -> ro_range_iterator & = default;
+
+    auto operator++() -> ro_range_iterator &
+    {
+        step_to_next();
+        return *this;
+    };
+
+    using base::operator++;
+
+    // Moves to the first item at or after key in the iteration order,
+    // clamped to the range.
+    auto seek(typename KeyTrait::value_type const &key) -> void
+        requires serilaization_trait<KeyTrait>
+    {
+        auto const key_bytes = KeyTrait::to_bytes(key);
+        auto const mdb_key = details::to_mdb_val(key_bytes);
+
+        if (is_forward()) {
+            auto const lower = to_mdb_val(_range.get().lower);
+            position_at_or_after(
+                lower && compare(mdb_key, *lower) < 0 ? &*lower : &mdb_key);
+        } else {
+            auto const upper = to_mdb_val(_range.get().upper);
+            if (upper && compare(mdb_key, *upper) >= 0)
+                position_before(&*upper, false);
+            else
+                position_before(&mdb_key, true);
+        }
+    }
+
+private:
+    auto step_to_next() -> void
+    {
+        base::navigate_cursor(is_forward() ? MDB_NEXT : MDB_PREV, nullptr);
+        check_bound();
+    }
+
+    auto position_at_or_after(MDB_val const *const key) -> void
+    {
+        base::navigate_cursor(
+            key != nullptr ? MDB_SET_RANGE : MDB_FIRST, key);
+        check_bound();
+    }
+
+    // positions at the last item before key, or at the last duplicate of
+    // key itself if inclusive
+    auto position_before(MDB_val const *const key, bool const inclusive)
+        -> void
+    {
+        if (key == nullptr) {
+            base::navigate_cursor(MDB_LAST, nullptr);
+        } else {
+            base::navigate_cursor(MDB_SET_RANGE, key);
+            if (base::error() == error_t::not_found) {
+                base::navigate_cursor(MDB_LAST, nullptr);
+            } else if (base::is_ok()) {
+                if (!inclusive || compare(base::current_key(), *key) != 0)
+                    base::navigate_cursor(MDB_PREV, nullptr);
+                else if (_range.get().duplicates_enabled)
+                    move_to_last_duplicate();
+            }
+        }
+        check_bound();
+    }
+
+    // MDB_LAST_DUP does not return the key
+    auto move_to_last_duplicate() -> void
+    {
+        base::navigate_cursor(MDB_LAST_DUP, nullptr);
+        if (base::is_ok())
+            base::navigate_cursor(MDB_GET_CURRENT, nullptr);
+    }
+
+    auto check_bound() -> void
+    {
+        if (!base::is_ok())
+            return;
+
+        if (is_forward()) {
+            if (auto const upper = to_mdb_val(_range.get().upper);
+                upper && compare(base::current_key(), *upper) >= 0)
+                base::set_end();
+            else if (auto const &prefix = _range.get().prefix;
+                     prefix && !has_prefix(base::current_key(), *prefix))
+                base::set_end();
+        } else {
+            if (auto const lower = to_mdb_val(_range.get().lower);
+                lower && compare(base::current_key(), *lower) < 0)
+                base::set_end();
+        }
+    }
+
+    static auto has_prefix(
+        MDB_val const &key, std::vector<std::byte> const &prefix) -> bool
+    {
+        auto const bytes = details::to_byte_span(key);
+        return bytes.size() >= prefix.size()
+               && std::equal(prefix.begin(), prefix.end(), bytes.begin());
+    }
+
+    auto compare(MDB_val const &lhs, MDB_val const &rhs) const -> int
+    {
+        auto const &range = _range.get();
+        return base::api().mdb_cmp(range.txn, range.dbi, &lhs, &rhs);
+    }
+
+    static auto to_mdb_val(std::optional<std::vector<std::byte>> const &key)
+        -> std::optional<MDB_val>
+    {
+        if (!key)
+            return std::nullopt;
+
+        return details::to_mdb_val(*key);
+    }
+
+    auto is_forward() const noexcept -> bool
+    {
+        return _range.get().direction == direction_t::forward;
+    }
+
+    std::reference_wrapper<details::cursor_range const> _range;
+};
+
+// A page of equally sized values of an MDB_DUPFIXED db. LMDB does not align
+// the page data, values are decoded from their bytes on access instead of
+// being read in place.
+template <deserialization_trait ValueTrait>
+class fixed_size_page {
+public:
+    using value_type = typename ValueTrait::value_type;
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = fixed_size_page::value_type;
+        using reference = value_type;
+        using difference_type = ptrdiff_t;
+
+        iterator() = default;
+
+        iterator(fixed_size_page const &page, size_t const index) noexcept
+            : _page{&page}
+            , _index{index}
+        {}
+
+        auto operator*() const -> value_type
+        {
+            return (*_page)[_index];
+        }
+
+        auto operator++() -> iterator &
+        {
+            ++_index;
+            return *this;
+        }
+
+        auto operator++(int) -> iterator
+        {
+            auto const previous = *this;
+            ++_index;
+            return previous;
+        }
+
+        auto operator==(iterator const &other) const -> bool
+        {
+            return _index == other._index;
+        }
+
+    private:
+        fixed_size_page const *_page{};
+        size_t _index{};
+    };
+
+    fixed_size_page(byte_span const &bytes, size_t const value_size) noexcept
+        : _bytes{bytes}
+        , _value_size{value_size}
+    {}
+
+    auto size() const noexcept -> size_t
+    {
+        return _bytes.size() / _value_size;
+    }
+
+    auto operator[](size_t const index) const -> value_type
+    {
+        return ValueTrait::from_bytes(
+            _bytes.subspan(index * _value_size, _value_size));
+    }
+
+    auto begin() const noexcept -> iterator
+    {
+        return {*this, 0};
+    }
+
+    auto end() const noexcept -> iterator
+    {
+        return {*this, size()};
+    }
+
+    // the encoded values, unaligned
+    auto bytes() const noexcept -> byte_span
+    {
+        return _bytes;
+    }
+
+private:
+    byte_span _bytes;
+    size_t _value_size;
+};
+
+// Iterates over the duplicates of a key of an MDB_DUPFIXED db a page at a
+// time (MDB_GET_MULTIPLE, MDB_NEXT_MULTIPLE). Pages point into the map and
+// decode their values on access.
+template <deserialization_trait ValueTrait, lmdb_api_like LmdbApi>
+class ro_page_iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = fixed_size_page<ValueTrait>;
+    using reference = value_type &;
+    using const_reference = value_type const &;
+    using difference_type = ptrdiff_t;
+
+public:
+    explicit ro_page_iterator(
+        LmdbApi const &api, MDB_cursor &cursor, byte_span const &key) noexcept
+        : _api{api}
+        , _cursor{cursor}
+        , _page{std::unexpected{error_t::not_found}}
+    {
+        auto mdb_key = details::to_mdb_val(key);
+        MDB_val mdb_value{};
+        if (auto const result = _api.get().mdb_cursor_get(
+                &_cursor.get(), &mdb_key, &mdb_value, MDB_SET);
+            result != MDB_SUCCESS) {
+            _page = std::unexpected{error_t{result}};
+            return;
+        }
+
+        // all duplicates of an MDB_DUPFIXED db have the size of the first
+        _value_size = mdb_value.mv_size;
+        navigate_cursor(MDB_GET_MULTIPLE);
+    }
+
+    ro_page_iterator(ro_page_iterator &&) = default;
+    auto operator=(ro_page_iterator &&) -> ro_page_iterator & = default;
+
+    auto operator++() -> ro_page_iterator &
+    {
+        navigate_cursor(MDB_NEXT_MULTIPLE);
+        return *this;
+    }
+
+    auto operator++(int) -> void
+    {
+        ++*this;
+    }
+
+    auto operator*() const -> const_reference
+    {
+        return *_page;
+    }
+
+    auto operator==(std::default_sentinel_t const &) const -> bool
+    {
+        return !_page.has_value();
+    }
+
+    auto error() const -> std::optional<error_t>
+    {
+        return !_page ? std::optional{_page.error()} : std::nullopt;
+    }
+
+private:
+    auto navigate_cursor(MDB_cursor_op const operation) -> void
+    {
+        MDB_val mdb_key{};
+        MDB_val mdb_value{};
+        if (auto const result = _api.get().mdb_cursor_get(
+                &_cursor.get(), &mdb_key, &mdb_value, operation);
+            result != MDB_SUCCESS) {
+            _page = std::unexpected{error_t{result}};
+            return;
+        }
+
+        _page = value_type{details::to_byte_span(mdb_value), _value_size};
+    }
+
+    std::reference_wrapper<LmdbApi const> _api;
+    std::reference_wrapper<MDB_cursor> _cursor;
+    size_t _value_size{1};
+    std::expected<value_type, error_t> _page;
+};
+
 }  // namespace lmdb
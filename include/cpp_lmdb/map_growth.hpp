@@ -0,0 +1,123 @@
+#pragma once
+
+#include "cpp_lmdb/error.hpp"
+
+// lmdb
+#include "lmdb.h"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <expected>
+#include <optional>
+
+namespace lmdb
+{
+
+struct map_growth_policy_t {
+    // each growth step multiplies the map size by this factor
+    size_t growth_factor{2};
+    // upper bound for the map size, zero means unbounded
+    size_t max_map_size{};
+    // number of replays of a write transaction that failed with map_full
+    size_t max_retries{8};
+    // free space kept ahead of the write path, zero disables preallocation
+    size_t min_free_size{};
+    // A change of the map size waits for the other transactions of the
+    // environment to end, for at most this long. A write then fails with
+    // map_full, a transaction begin with map_resized.
+    std::chrono::milliseconds max_resize_wait{1000};
+
+    constexpr auto next_map_size(size_t const current) const -> size_t
+    {
+        auto const next = current * std::max(growth_factor, size_t{2});
+        return max_map_size != 0 ? std::min(next, max_map_size) : next;
+    }
+};
+
+namespace details
+{
+// The functions changing the map size require that no other transaction of
+// the process is active, see map_resize_guard.
+template <typename LmdbApi>
+auto grow_map(
+    LmdbApi const &api, MDB_env &env, map_growth_policy_t const &policy)
+    -> std::expected<void, error_t>
+{
+    MDB_envinfo info{};
+    if (auto const result = api.mdb_env_info(&env, &info);
+        result != MDB_SUCCESS)
+        return std::unexpected{error_t{result}};
+
+    auto const new_size = policy.next_map_size(info.me_mapsize);
+    if (new_size <= info.me_mapsize)
+        return std::unexpected{error_t::map_full};
+
+    if (auto const result = api.mdb_env_set_mapsize(&env, new_size);
+        result != MDB_SUCCESS)
+        return std::unexpected{error_t{result}};
+
+    return {};
+}
+
+// map size keeping policy.min_free_size free, nullopt if the current size
+// does
+template <typename LmdbApi>
+auto map_size_with_headroom(
+    LmdbApi const &api, MDB_env &env, map_growth_policy_t const &policy)
+    -> std::expected<std::optional<size_t>, error_t>
+{
+    if (policy.min_free_size == 0)
+        return std::nullopt;
+
+    MDB_envinfo info{};
+    if (auto const result = api.mdb_env_info(&env, &info);
+        result != MDB_SUCCESS)
+        return std::unexpected{error_t{result}};
+
+    MDB_stat stat{};
+    if (auto const result = api.mdb_env_stat(&env, &stat);
+        result != MDB_SUCCESS)
+        return std::unexpected{error_t{result}};
+
+    auto const used_size = (info.me_last_pgno + 1) * stat.ms_psize;
+    auto new_size = info.me_mapsize;
+    while (new_size < used_size + policy.min_free_size) {
+        auto const next_size = policy.next_map_size(new_size);
+        if (next_size <= new_size)
+            break;
+        new_size = next_size;
+    }
+
+    if (new_size == info.me_mapsize)
+        return std::nullopt;
+
+    return new_size;
+}
+
+template <typename LmdbApi>
+auto set_map_size(LmdbApi const &api, MDB_env &env, size_t const map_size)
+    -> std::expected<void, error_t>
+{
+    if (auto const result = api.mdb_env_set_mapsize(&env, map_size);
+        result != MDB_SUCCESS)
+        return std::unexpected{error_t{result}};
+
+    return {};
+}
+
+template <typename LmdbApi>
+auto adopt_resized_map(LmdbApi const &api, MDB_env &env)
+    -> std::expected<void, error_t>
+{
+    // zero size makes LMDB pick up the size set by another process
+    if (auto const result = api.mdb_env_set_mapsize(&env, 0);
+        result != MDB_SUCCESS)
+        return std::unexpected{error_t{result}};
+
+    return {};
+}
+
+}  // namespace details
+}  // namespace lmdb
@@ -0,0 +1,603 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/dbs.hpp"
+#include "cpp_lmdb/error.hpp"
+#include "cpp_lmdb/transactions.hpp"
+#include "cpp_lmdb/types.hpp"
+
+// details
+#include "cpp_lmdb/details/commit_listener.hpp"
+#include "cpp_lmdb/details/key_value_traits.hpp"
+
+// lmdb
+#include "lmdb.h"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace lmdb
+{
+struct membership_filter_options_t {
+    // the filter is sized once for this many keys, more keys raise the
+    // false positive rate
+    size_t expected_keys{size_t{1} << 20U};
+    // 10 bits per key give about 1% false positives
+    size_t bits_per_key{10};
+};
+
+struct membership_filter_stats_t {
+    size_t lookups;
+    // lookups answered by the filter without touching the db
+    size_t definite_misses;
+    // lookups let through by the filter which found nothing
+    size_t false_positives;
+};
+
+// Side db of a membership_filter: the filter bits in chunks keyed by their
+// index, in native byte order, and a header under the largest key.
+using membership_filter_db_trait
+    = unique_key<trivial_trait<uint32_t>, byte_vector_trait>;
+
+namespace details
+{
+// MurmurHash64A, the hashes of the keys are persisted with the filter
+inline auto filter_hash(std::span<std::byte const> const bytes) noexcept
+    -> uint64_t
+{
+    constexpr uint64_t multiplier{0xc6a4a7935bd1e995ULL};
+    constexpr unsigned shift{47};
+
+    uint64_t hash = 0x8445d61a4e774912ULL ^ (bytes.size() * multiplier);
+    size_t offset{};
+    for (; offset + sizeof(uint64_t) <= bytes.size();
+         offset += sizeof(uint64_t)) {
+        uint64_t word{};
+        std::memcpy(&word, bytes.data() + offset, sizeof(word));
+        word *= multiplier;
+        word ^= word >> shift;
+        word *= multiplier;
+        hash ^= word;
+        hash *= multiplier;
+    }
+
+    if (offset < bytes.size()) {
+        uint64_t tail{};
+        for (size_t i = 0; offset + i < bytes.size(); ++i)
+            tail |= std::to_integer<uint64_t>(bytes[offset + i]) << (8 * i);
+        hash ^= tail;
+        hash *= multiplier;
+    }
+
+    hash ^= hash >> shift;
+    hash *= multiplier;
+    hash ^= hash >> shift;
+    return hash;
+}
+
+struct membership_filter_header {
+    uint32_t version;
+    uint32_t hash_count;
+    uint64_t block_count;
+    // keys were written without the filter seeing them
+    uint64_t stale;
+};
+}  // namespace details
+
+// Blocked Bloom filter over the keys of a db, answering most lookups of
+// absent keys without walking the B-tree. Each key sets hash_count bits in
+// one 512-bit block, so a lookup touches a single cache line.
+//
+// The filter is a commit listener of the db: the keys of each commit are
+// added, and the 4 KiB chunks of the filter they touched are written to the
+// side db, in the committing MDB_txn, so the persisted filter never misses
+// a committed key. Deleted keys keep their bits until rebuild() drops them.
+// The side db must live in the env of the db, and all writes to the db must
+// go through the rw_db the filter is attached to: other writers (other
+// processes, multi_transaction) are not seen, and neither are transactions
+// begun before the filter was opened, which mark the filter stale until the
+// next rebuild. A stale filter lets every lookup through.
+//
+// get and get_many take a ro transaction; reads of a write transaction do
+// not see its own uncommitted keys in the filter and must go to the db.
+template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi>
+    requires(!details::key_value_trait_helper<
+             KeyValueTrait>::duplicates_enabled)
+class membership_filter : private details::commit_listener<LmdbApi> {
+public:
+    using db_type = rw_db<KeyValueTrait, LmdbApi>;
+    using filter_db_type = rw_db<membership_filter_db_trait, LmdbApi>;
+    using ro_transaction = typename db_type::ro_transaction;
+    using key_type = typename KeyValueTrait::key_trait::value_type;
+    using value_type = typename KeyValueTrait::value_trait::value_type;
+
+public:
+    // Attaches a filter to db, loaded from filter_db, or built from the db
+    // when filter_db holds no valid one; options only size a new filter.
+    static auto open(
+        db_type &db,
+        filter_db_type &filter_db,
+        membership_filter_options_t const &options = {})
+        -> std::expected<std::unique_ptr<membership_filter>, error_t>
+    {
+        std::unique_ptr<membership_filter> filter{
+            new membership_filter{db, filter_db, options}};
+
+        auto const loaded = filter->attach();
+        if (!loaded)
+            return std::unexpected{loaded.error()};
+        if (!*loaded) {
+            if (auto const result = filter->rebuild(); !result)
+                return std::unexpected{result.error()};
+        }
+        return filter;
+    }
+
+    membership_filter(membership_filter const &) = delete;
+    auto operator=(membership_filter const &)
+        -> membership_filter & = delete;
+
+    ~membership_filter() override
+    {
+        if (_attached)
+            _db.remove_commit_listener(this);
+    }
+
+    // false when key is definitely not in the latest snapshot
+    auto may_contain(key_type const &key) const noexcept -> bool
+    {
+        auto const key_bytes = KeyValueTrait::key_trait::to_bytes(key);
+        return may_contain(
+            std::numeric_limits<size_t>::max(),
+            std::span<std::byte const>{key_bytes});
+    }
+
+    auto get(ro_transaction const &txn, key_type const &key) const
+        -> std::expected<value_type, error_t>
+    {
+        _lookups.fetch_add(1, std::memory_order_relaxed);
+
+        auto const key_bytes = KeyValueTrait::key_trait::to_bytes(key);
+        if (!may_contain(txn.id(), std::span<std::byte const>{key_bytes})) {
+            _definite_misses.fetch_add(1, std::memory_order_relaxed);
+            return std::unexpected{error_t::not_found};
+        }
+
+        auto value = txn.get(key);
+        if (!value && value.error() == error_t::not_found)
+            _false_positives.fetch_add(1, std::memory_order_relaxed);
+        return value;
+    }
+
+    // see transaction::get_many, definite misses are not looked up
+    template <std::ranges::random_access_range Keys>
+    auto get_many(
+        ro_transaction const &txn,
+        Keys const &keys,
+        std::span<std::expected<value_type, error_t>> const results) const
+        -> std::expected<void, error_t>
+        requires(
+            std::same_as<std::ranges::range_value_t<Keys>, key_type>
+            && std::is_lvalue_reference_v<
+                std::ranges::range_reference_t<Keys const>>)
+    {
+        auto const count = static_cast<size_t>(std::ranges::size(keys));
+        if (results.size() < count)
+            return std::unexpected{error_t::invalid_argument};
+
+        _lookups.fetch_add(count, std::memory_order_relaxed);
+
+        auto const snapshot = txn.id();
+        std::vector<size_t> candidates;
+        candidates.reserve(count);
+        for (size_t index = 0; index < count; ++index) {
+            auto const key_bytes = KeyValueTrait::key_trait::to_bytes(
+                std::ranges::begin(keys)[index]);
+            if (may_contain(snapshot, std::span<std::byte const>{key_bytes}))
+                candidates.push_back(index);
+            else
+                results[index] = std::unexpected{error_t::not_found};
+        }
+        _definite_misses.fetch_add(
+            count - candidates.size(), std::memory_order_relaxed);
+
+        std::vector<key_type> candidate_keys;
+        candidate_keys.reserve(candidates.size());
+        for (auto const index : candidates)
+            candidate_keys.push_back(std::ranges::begin(keys)[index]);
+
+        std::vector<std::expected<value_type, error_t>> found(
+            candidates.size());
+        if (auto const result = txn.get_many(candidate_keys, found); !result)
+            return result;
+
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (!found[i] && found[i].error() == error_t::not_found)
+                _false_positives.fetch_add(1, std::memory_order_relaxed);
+            results[candidates[i]] = std::move(found[i]);
+        }
+        return {};
+    }
+
+    // Rebuilds the filter from a snapshot of the db, dropping the bits of
+    // deleted keys, and persists it. Readers and writers keep going
+    // meanwhile, e.g. with rebuild() running on a background thread: keys
+    // committed during the scan are added to the new filter too. Must not
+    // be called by a thread holding a transaction of the env.
+    auto rebuild() -> std::expected<void, error_t>
+    {
+        std::lock_guard const lock{_rebuild_mutex};
+        {
+            std::lock_guard const next_lock{_next_mutex};
+            _next = std::make_unique<std::atomic<uint64_t>[]>(word_count());
+            _next_lost_keys = false;
+        }
+
+        auto const result = rebuild_from_snapshot();
+        if (!result) {
+            std::lock_guard const next_lock{_next_mutex};
+            _next.reset();
+        }
+        return result;
+    }
+
+    auto stale() const noexcept -> bool
+    {
+        return _stale.load(std::memory_order_acquire);
+    }
+
+    auto stats() const noexcept -> membership_filter_stats_t
+    {
+        return {
+            .lookups = _lookups.load(std::memory_order_relaxed),
+            .definite_misses
+            = _definite_misses.load(std::memory_order_relaxed),
+            .false_positives
+            = _false_positives.load(std::memory_order_relaxed),
+        };
+    }
+
+private:
+    using side_db_accessor = details::transaction_base<
+        membership_filter_db_trait,
+        read_only_t::no,
+        LmdbApi>;
+
+    static constexpr uint32_t version{1};
+    static constexpr uint32_t header_key{
+        std::numeric_limits<uint32_t>::max()};
+    static constexpr size_t words_per_block{8};
+    static constexpr size_t bits_per_block{words_per_block * 64};
+    static constexpr size_t blocks_per_chunk{64};
+    static constexpr size_t words_per_chunk{
+        words_per_block * blocks_per_chunk};
+    static constexpr uint32_t max_hash_count{16};
+
+    struct probe_t {
+        size_t first_word;
+        uint32_t bit;
+        // odd, so the hash_count bits of a key are distinct
+        uint32_t step;
+    };
+
+    membership_filter(
+        db_type &db,
+        filter_db_type &filter_db,
+        membership_filter_options_t const &options)
+        : _db{db}
+        , _filter_db{filter_db}
+    {
+        auto const bits = std::max(
+            options.expected_keys * options.bits_per_key, bits_per_block);
+        auto const chunks = (bits + bits_per_block * blocks_per_chunk - 1)
+                            / (bits_per_block * blocks_per_chunk);
+        auto const hash_count = std::lround(
+            static_cast<double>(options.bits_per_key) * std::log(2.0));
+        resize(
+            chunks * blocks_per_chunk,
+            std::clamp(
+                static_cast<uint32_t>(hash_count), 1U, max_hash_count));
+    }
+
+    auto resize(size_t const block_count, uint32_t const hash_count) -> void
+    {
+        _block_count = block_count;
+        _hash_count = hash_count;
+        _words = std::make_unique<std::atomic<uint64_t>[]>(word_count());
+    }
+
+    auto word_count() const noexcept -> size_t
+    {
+        return _block_count * words_per_block;
+    }
+
+    auto chunk_count() const noexcept -> size_t
+    {
+        return _block_count / blocks_per_chunk;
+    }
+
+    auto probe(std::span<std::byte const> const key) const noexcept
+        -> probe_t
+    {
+        auto const hash = details::filter_hash(key);
+        auto const block = ((hash >> 32U) * _block_count) >> 32U;
+        return {
+            .first_word = static_cast<size_t>(block) * words_per_block,
+            .bit = static_cast<uint32_t>(hash),
+            .step = static_cast<uint32_t>(hash >> 17U) | 1U};
+    }
+
+    auto test(std::atomic<uint64_t> const *const words, probe_t const &probe)
+        const noexcept -> bool
+    {
+        for (uint32_t i = 0; i < _hash_count; ++i) {
+            auto const bit = (probe.bit + i * probe.step) % bits_per_block;
+            auto const word
+                = words[probe.first_word + bit / 64].load(
+                    std::memory_order_acquire);
+            if ((word & (uint64_t{1} << (bit % 64))) == 0)
+                return false;
+        }
+        return true;
+    }
+
+    auto set(std::atomic<uint64_t> *const words, probe_t const &probe)
+        const noexcept -> void
+    {
+        for (uint32_t i = 0; i < _hash_count; ++i) {
+            auto const bit = (probe.bit + i * probe.step) % bits_per_block;
+            words[probe.first_word + bit / 64].fetch_or(
+                uint64_t{1} << (bit % 64), std::memory_order_release);
+        }
+    }
+
+    // snapshot is the id of the snapshot the key is looked up in
+    auto may_contain(
+        size_t const snapshot,
+        std::span<std::byte const> const key) const noexcept -> bool
+    {
+        if (_stale.load(std::memory_order_acquire))
+            return true;
+        if (test(_words.get(), probe(key)))
+            return true;
+
+        // a rebuild drops the keys deleted since older snapshots; the bits
+        // are loaded first, so seeing rebuilt bits means seeing _built_at
+        return _built_at.load(std::memory_order_acquire) > snapshot;
+    }
+
+    auto before_commit(
+        LmdbApi const &api,
+        MDB_txn *const txn,
+        details::written_keys_t const *const keys)
+        -> std::expected<void, error_t> override
+    {
+        side_db_accessor side{_filter_db.db_index(), txn, api};
+
+        std::lock_guard const lock{_next_mutex};
+        if (keys == nullptr) {
+            _stale.store(true, std::memory_order_release);
+            if (_next)
+                _next_lost_keys = true;
+            return write_header(side, true);
+        }
+
+        std::vector<uint32_t> chunks;
+        chunks.reserve(keys->size());
+        for (auto const &key : *keys) {
+            auto const key_probe = probe(key);
+            set(_words.get(), key_probe);
+            if (_next)
+                set(_next.get(), key_probe);
+            chunks.push_back(
+                static_cast<uint32_t>(key_probe.first_word / words_per_chunk));
+        }
+
+        std::ranges::sort(chunks);
+        auto const duplicates = std::ranges::unique(chunks);
+        chunks.erase(duplicates.begin(), duplicates.end());
+
+        for (auto const chunk : chunks) {
+            if (auto const result = write_chunk(side, chunk); !result)
+                return result;
+        }
+        return {};
+    }
+
+    template <typename Accessor>
+    auto write_chunk(Accessor &accessor, uint32_t const chunk) const
+        -> std::expected<void, error_t>
+    {
+        std::vector<std::byte> bytes(words_per_chunk * sizeof(uint64_t));
+        auto const first_word = chunk * words_per_chunk;
+        for (size_t i = 0; i < words_per_chunk; ++i) {
+            auto const word
+                = _words[first_word + i].load(std::memory_order_relaxed);
+            std::memcpy(
+                bytes.data() + i * sizeof(uint64_t), &word, sizeof(word));
+        }
+        return accessor.insert(chunk, bytes);
+    }
+
+    template <typename Accessor>
+    auto write_header(Accessor &accessor, bool const stale) const
+        -> std::expected<void, error_t>
+    {
+        details::membership_filter_header const header{
+            .version = version,
+            .hash_count = _hash_count,
+            .block_count = _block_count,
+            .stale = stale ? 1U : 0U};
+
+        std::vector<std::byte> bytes(sizeof(header));
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        return accessor.insert(header_key, bytes);
+    }
+
+    // Loads the persisted filter and attaches to the db within a write
+    // transaction, so no commit falls in between. Returns false when the
+    // filter is missing, stale or incomplete: it is marked stale until
+    // rebuilt.
+    auto attach() -> std::expected<bool, error_t>
+    {
+        auto txn = _filter_db.begin_rw_transaction();
+        if (!txn)
+            return std::unexpected{txn.error()};
+
+        auto const loaded = load_chunks(*txn);
+        if (!loaded)
+            return std::unexpected{loaded.error()};
+        if (!*loaded) {
+            resize(_block_count, _hash_count);
+            _stale.store(true, std::memory_order_release);
+            if (auto const result = write_header(*txn, true); !result)
+                return std::unexpected{result.error()};
+        }
+
+        _db.add_commit_listener(this);
+        _attached = true;
+        if (auto const result = _filter_db.commit_transaction(std::move(*txn));
+            !result)
+            return std::unexpected{result.error()};
+
+        return *loaded;
+    }
+
+    template <typename Transaction>
+    auto load_chunks(Transaction const &txn) -> std::expected<bool, error_t>
+    {
+        auto const header_bytes = txn.get(header_key);
+        if (!header_bytes && header_bytes.error() == error_t::not_found)
+            return false;
+        if (!header_bytes)
+            return std::unexpected{header_bytes.error()};
+
+        details::membership_filter_header header{};
+        if (header_bytes->size() != sizeof(header))
+            return false;
+        std::memcpy(&header, header_bytes->data(), sizeof(header));
+        if (header.version != version || header.stale != 0
+            || header.block_count == 0
+            || header.block_count % blocks_per_chunk != 0
+            || header.block_count / blocks_per_chunk >= header_key
+            || header.hash_count == 0 || header.hash_count > max_hash_count)
+            return false;
+
+        resize(static_cast<size_t>(header.block_count), header.hash_count);
+
+        auto const view = txn.iterate();
+        if (!view)
+            return std::unexpected{view.error()};
+
+        size_t loaded{};
+        for (auto const &item : *view) {
+            auto const chunk = item.key();
+            if (chunk == header_key)
+                continue;
+
+            auto const bytes = item.value();
+            if (chunk >= chunk_count()
+                || bytes.size() != words_per_chunk * sizeof(uint64_t))
+                return false;
+
+            for (size_t i = 0; i < words_per_chunk; ++i) {
+                uint64_t word{};
+                std::memcpy(
+                    &word,
+                    bytes.data() + i * sizeof(uint64_t),
+                    sizeof(word));
+                _words[chunk * words_per_chunk + i].store(
+                    word, std::memory_order_relaxed);
+            }
+            ++loaded;
+        }
+        return loaded == chunk_count();
+    }
+
+    auto rebuild_from_snapshot() -> std::expected<void, error_t>
+    {
+        // a writer which missed the new filter began its transaction before
+        // this one, so it has committed before the snapshot below
+        if (auto const fence = _filter_db.begin_rw_transaction(); !fence)
+            return std::unexpected{fence.error()};
+
+        size_t snapshot{};
+        {
+            auto const txn = _db.begin_ro_transaction();
+            if (!txn)
+                return std::unexpected{txn.error()};
+            auto const view = txn->iterate();
+            if (!view)
+                return std::unexpected{view.error()};
+
+            snapshot = txn->id();
+            for (auto const &item : *view)
+                set(_next.get(), probe(item.key_bytes()));
+        }
+
+        auto txn = _filter_db.begin_rw_transaction();
+        if (!txn)
+            return std::unexpected{txn.error()};
+
+        // Writers are excluded by the write transaction. Both filters hold
+        // the keys of the latest snapshot, so readers racing the copy see
+        // every present key in either word.
+        {
+            std::lock_guard const lock{_next_mutex};
+            _built_at.store(snapshot, std::memory_order_seq_cst);
+            for (size_t i = 0; i < word_count(); ++i) {
+                _words[i].store(
+                    _next[i].load(std::memory_order_relaxed),
+                    std::memory_order_release);
+            }
+            _next.reset();
+            _stale.store(_next_lost_keys, std::memory_order_release);
+        }
+
+        for (uint32_t chunk = 0; chunk < chunk_count(); ++chunk) {
+            if (auto const result = write_chunk(*txn, chunk); !result)
+                return result;
+        }
+        if (auto const result = write_header(*txn, stale()); !result)
+            return result;
+
+        return _filter_db.commit_transaction(std::move(*txn));
+    }
+
+    db_type &_db;
+    filter_db_type &_filter_db;
+
+    size_t _block_count{};
+    uint32_t _hash_count{};
+    std::unique_ptr<std::atomic<uint64_t>[]> _words;
+    std::atomic<bool> _stale{};
+    // id of the snapshot the last rebuild scanned
+    std::atomic<size_t> _built_at{};
+    bool _attached{};
+
+    std::mutex _rebuild_mutex;
+    // the filter being rebuilt, writers add their keys to it as well
+    std::mutex _next_mutex;
+    std::unique_ptr<std::atomic<uint64_t>[]> _next;
+    bool _next_lost_keys{};
+
+    mutable std::atomic<size_t> _lookups{};
+    mutable std::atomic<size_t> _definite_misses{};
+    mutable std::atomic<size_t> _false_positives{};
+};
+
+}  // namespace lmdb
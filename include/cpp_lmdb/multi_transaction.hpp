@@ -0,0 +1,107 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/transactions.hpp"
+#include "cpp_lmdb/types.hpp"
+
+// details
+#include "cpp_lmdb/details/details.hpp"
+#include "cpp_lmdb/details/key_value_traits.hpp"
+
+// lmdb
+#include "lmdb.h"
+
+// std
+#include <array>
+#include <expected>
+#include <tuple>
+#include <utility>
+
+namespace lmdb
+{
+template <lmdb_api_like LmdbApi>
+class rw_environment;
+
+// Single MDB_txn spanning several typed dbs of one environment. Each db is
+// accessed with db<Index>() in the order the dbs were passed to
+// begin_rw_transaction/begin_ro_transaction of the environment.
+template <
+    read_only_t ReadOnly,
+    lmdb_api_like LmdbApi,
+    key_value_trait... KeyValueTraits>
+class multi_transaction {
+    template <lmdb_api_like>
+    friend class rw_environment;
+
+public:
+    template <size_t Index>
+    using db_accessor = details::transaction_base<
+        std::tuple_element_t<Index, std::tuple<KeyValueTraits...>>,
+        ReadOnly,
+        LmdbApi>;
+
+    using db_indices_t = std::array<MDB_dbi, sizeof...(KeyValueTraits)>;
+
+public:
+    multi_transaction(
+        details::txn_unique_ptr_t<LmdbApi> &&txn,
+        db_indices_t const &db_indices) noexcept
+        : _txn{std::move(txn)}
+        , _dbs{make_dbs(
+              db_indices,
+              _txn.get(),
+              _txn.get_deleter().api,
+              std::index_sequence_for<KeyValueTraits...>{})}
+    {}
+
+    multi_transaction(multi_transaction &&) noexcept = default;
+
+    template <size_t Index>
+    auto db() noexcept -> db_accessor<Index> &
+    {
+        return std::get<Index>(_dbs);
+    }
+
+    template <size_t Index>
+    auto db() const noexcept -> db_accessor<Index> const &
+    {
+        return std::get<Index>(_dbs);
+    }
+
+private:
+    template <size_t... Indices>
+    static auto make_dbs(
+        db_indices_t const &db_indices,
+        MDB_txn *const txn,
+        LmdbApi const &api,
+        std::index_sequence<Indices...>)
+    {
+        return std::tuple<
+            details::transaction_base<KeyValueTraits, ReadOnly, LmdbApi>...>{
+            details::transaction_base<KeyValueTraits, ReadOnly, LmdbApi>{
+                db_indices[Indices], txn, api}...};
+    }
+
+    auto commit() && noexcept -> std::expected<void, error_t>
+        requires(ReadOnly == read_only_t::no)
+    {
+        std::apply(
+            [](auto &...dbs) { (dbs.release_cursors(), ...); }, _dbs);
+
+        auto &api = _txn.get_deleter().api;
+        if (auto const result = details::commit_tx(api, std::move(_txn));
+            !result) {
+            return std::unexpected{error_t{result.error()}};
+        }
+
+        return {};
+    }
+
+private:
+    details::txn_unique_ptr_t<LmdbApi> _txn;
+    // declared after _txn to close cached cursors before the txn ends
+    std::tuple<details::transaction_base<KeyValueTraits, ReadOnly, LmdbApi>...>
+        _dbs;
+};
+
+}  // namespace lmdb
@@ -0,0 +1,89 @@
+#pragma once
+
+// details
+#include "cpp_lmdb/details/key_value_traits.hpp"
+#include "cpp_lmdb/details/ordered_encoding.hpp"
+
+// std
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace lmdb
+{
+
+template <typename T>
+concept numeric = (std::integral<T> && !std::same_as<T, bool>)
+                  || std::floating_point<T>;
+
+namespace details
+{
+// LMDB compares MDB_INTEGERKEY keys as native unsigned int or size_t
+template <typename T>
+inline constexpr bool fits_integer_key_v
+    = requires { typename ordered_bits<T>::type; }
+      && (sizeof(T) == sizeof(unsigned int) || sizeof(T) == sizeof(size_t));
+
+template <size_t Size>
+struct alignas(Size) aligned_bytes : std::array<std::byte, Size> {};
+}  // namespace details
+
+// Numeric trait encoding values in big-endian order-preserving form (see
+// details::ordered_bits), sorted by LMDB's default memcmp comparator. Works
+// for every size and supports prefix scans and sampled partitions.
+template <numeric T>
+    requires requires { typename details::ordered_bits<T>::type; }
+struct ordered_numeric_trait {
+    using value_type = T;
+
+    static auto to_bytes(value_type const value)
+        -> std::array<std::byte, sizeof(T)>
+    {
+        return details::ordered_codec<T>::encode_fixed(value, std::byte{});
+    }
+
+    static auto from_bytes(std::span<std::byte const> const &bytes)
+        -> value_type
+    {
+        auto remaining = bytes;
+        return details::ordered_codec<T>::decode(remaining, std::byte{});
+    }
+};
+
+// Numeric trait picking the fastest representation that sorts correctly.
+// Values of the size of unsigned int or size_t are stored as native
+// unsigned integers of their ordered bits and compared by LMDB as integers
+// (MDB_INTEGERKEY, MDB_INTEGERDUP for values of duplicate_key dbs); other
+// sizes fall back to ordered_numeric_trait.
+template <numeric T>
+struct numeric_trait : ordered_numeric_trait<T> {};
+
+template <numeric T>
+    requires details::fits_integer_key_v<T>
+struct numeric_trait<T> {
+    using value_type = T;
+    using integer_flag = std::true_type;
+
+    static auto to_bytes(value_type const value)
+        -> details::aligned_bytes<sizeof(T)>
+    {
+        auto const bits = details::ordered_bits<T>::to(value);
+
+        details::aligned_bytes<sizeof(T)> bytes;
+        std::memcpy(bytes.data(), &bits, sizeof(T));
+        return bytes;
+    }
+
+    static auto from_bytes(std::span<std::byte const> const &bytes)
+        -> value_type
+    {
+        typename details::ordered_bits<T>::type bits{};
+        std::memcpy(&bits, bytes.data(), sizeof(T));
+        return details::ordered_bits<T>::from(bits);
+    }
+};
+
+}  // namespace lmdb
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/dbs.hpp"
+#include "cpp_lmdb/error.hpp"
+
+// details
+#include "cpp_lmdb/details/key_value_traits.hpp"
+
+// std
+#include <algorithm>
+#include <barrier>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <expected>
+#include <optional>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Scans of a whole db split into key ranges, each one walked by its own
+// thread with its own read-only transaction. Partial results are reduced in
+// the key order of the partitions on the calling thread.
+namespace lmdb
+{
+struct parallel_scan_options_t {
+    // number of times the partition transactions are reopened when a
+    // commit lands while they are being opened, the scan runs on mixed
+    // snapshots once the retries are exhausted
+    size_t snapshot_retries{4};
+};
+
+namespace details
+{
+// Big-endian interpolation over the first 8 bytes following the common
+// prefix of the keys, i.e. split points in the bytewise order of LMDB.
+inline auto interpolate_key_bytes(
+    std::span<std::byte const> const first,
+    std::span<std::byte const> const last,
+    size_t const index,
+    size_t const count) -> std::vector<std::byte>
+{
+    constexpr size_t window_size{sizeof(uint64_t)};
+
+    auto const prefix = static_cast<size_t>(
+        std::ranges::mismatch(first, last).in1 - first.begin());
+    auto const window = [prefix](std::span<std::byte const> const bytes) {
+        uint64_t value{};
+        for (size_t i = 0; i < window_size; ++i) {
+            value <<= 8U;
+            if (prefix + i < bytes.size())
+                value |= std::to_integer<uint64_t>(bytes[prefix + i]);
+        }
+        return value;
+    };
+
+    auto const lower = window(first);
+    auto const distance = window(last) - lower;
+    auto const value = lower + distance / count * index
+                       + distance % count * index / count;
+
+    std::vector<std::byte> bytes{first.begin(), first.begin() + prefix};
+    for (size_t i = 0; i < window_size; ++i) {
+        bytes.push_back(
+            static_cast<std::byte>(value >> (8U * (window_size - 1 - i))));
+    }
+    return bytes;
+}
+
+// LMDB does not expose its branch pages, so the split points are
+// interpolated between the first and the last key instead of being taken
+// from the tree. Evenly spread keys give evenly sized partitions.
+template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi>
+auto sample_split_points(
+    ro_db<KeyValueTrait, LmdbApi> const &db, size_t const partition_count)
+    -> std::expected<
+        std::vector<typename KeyValueTrait::key_trait::value_type>,
+        error_t>
+{
+    using key_trait = typename KeyValueTrait::key_trait;
+    using key_type = typename key_trait::value_type;
+
+    auto txn = db.begin_ro_transaction();
+    if (!txn)
+        return std::unexpected{txn.error()};
+
+    auto forward = txn->iterate();
+    if (!forward)
+        return std::unexpected{forward.error()};
+    auto backward = txn->iterate_reverse();
+    if (!backward)
+        return std::unexpected{backward.error()};
+
+    auto const first = forward->begin();
+    auto const last = backward->begin();
+    if (first == forward->end() || last == backward->end()) {
+        auto const error = first.error() ? first.error() : last.error();
+        if (error && *error != error_t::not_found)
+            return std::unexpected{*error};
+        return std::vector<key_type>{};
+    }
+
+    key_type const first_key = (*first).key();
+    key_type const last_key = (*last).key();
+
+    std::vector<key_type> split_points;
+    if constexpr (key_value_trait_helper<KeyValueTrait>::is_integer_key) {
+        // MDB_INTEGERKEY keys are stored as native unsigned integers
+        using integer_type = std::conditional_t<
+            sizeof(key_type) == sizeof(unsigned int),
+            unsigned int,
+            size_t>;
+        auto const to_integer = [](key_type const &key) {
+            auto const bytes = key_trait::to_bytes(key);
+            integer_type value{};
+            std::memcpy(&value, bytes.data(), sizeof(value));
+            return value;
+        };
+
+        auto const first_value = to_integer(first_key);
+        auto const distance = to_integer(last_key) - first_value;
+        auto previous = first_value;
+        for (size_t i = 1; i < partition_count; ++i) {
+            integer_type const value = first_value
+                                       + distance / partition_count * i
+                                       + distance % partition_count * i
+                                             / partition_count;
+            if (value <= previous)
+                continue;
+
+            split_points.push_back(key_trait::from_bytes(
+                std::as_bytes(std::span{&value, 1})));
+            previous = value;
+        }
+    } else {
+        auto const first_bytes = key_trait::to_bytes(first_key);
+        auto const last_bytes = key_trait::to_bytes(last_key);
+
+        std::vector<std::byte> previous{
+            first_bytes.begin(), first_bytes.end()};
+        for (size_t i = 1; i < partition_count; ++i) {
+            auto bytes = interpolate_key_bytes(
+                first_bytes, last_bytes, i, partition_count);
+            if constexpr (trivially_serealizable<key_type>)
+                bytes.resize(first_bytes.size());
+
+            if (!std::ranges::lexicographical_compare(previous, bytes))
+                continue;
+
+            split_points.push_back(key_trait::from_bytes(bytes));
+            previous = std::move(bytes);
+        }
+    }
+
+    return split_points;
+}
+
+template <typename Result, typename Transaction, typename Key, typename Map>
+auto scan_partition(
+    Transaction const &txn, Key const *lower, Key const *upper, Map &map)
+    -> std::expected<Result, error_t>
+{
+    auto const scan = [&map](auto view) -> std::expected<Result, error_t> {
+        if (!view)
+            return std::unexpected{view.error()};
+        return map(*view);
+    };
+
+    if (lower && upper)
+        return scan(txn.iterate_range(*lower, *upper));
+    if (lower)
+        return scan(txn.iterate_from(*lower));
+    if (upper)
+        return scan(txn.iterate_to(*upper));
+    return scan(txn.iterate());
+}
+}  // namespace details
+
+// Scans the partitions [-inf, boundaries[0]), [boundaries[0],
+// boundaries[1]), ..., [boundaries[n - 1], inf) on n + 1 threads. The
+// boundaries must be sorted in the db order. map is called with the view of
+// a partition (ro_view or ro_range_view, so it usually takes auto &) and
+// returns its partial result; reduce(Result, Result) folds the partials into
+// init in partition order. The partition transactions are opened in lock
+// step and reopened until they read the same snapshot, see
+// parallel_scan_options_t. An exception thrown by map is rethrown once all
+// partitions are done.
+template <
+    key_value_trait KeyValueTrait,
+    lmdb_api_like LmdbApi,
+    typename Result,
+    typename Map,
+    typename Reduce>
+auto parallel_scan(
+    ro_db<KeyValueTrait, LmdbApi> const &db,
+    std::span<typename KeyValueTrait::key_trait::value_type const> const
+        boundaries,
+    Result init,
+    Map map,
+    Reduce reduce,
+    parallel_scan_options_t const &options = {})
+    -> std::expected<Result, error_t>
+{
+    using partial_type = std::expected<Result, error_t>;
+
+    auto const partition_count = boundaries.size() + 1;
+    std::vector<std::optional<partial_type>> partials(partition_count);
+    std::vector<std::exception_ptr> exceptions(partition_count);
+
+    // written by every worker before the barrier, read by its completion
+    std::vector<size_t> snapshot_ids(partition_count);
+    size_t attempts{};
+    bool same_snapshot{};
+    std::barrier sync{
+        static_cast<std::ptrdiff_t>(partition_count), [&]() noexcept {
+            same_snapshot = std::ranges::all_of(
+                snapshot_ids, [&snapshot_ids](size_t const id) {
+                    return id != 0 && id == snapshot_ids.front();
+                });
+            ++attempts;
+        }};
+
+    auto const scan = [&](size_t const partition) {
+        std::optional<typename ro_db<KeyValueTrait, LmdbApi>::ro_transaction>
+            txn;
+        std::optional<error_t> error;
+        while (true) {
+            // a thread can only hold one read-only transaction
+            txn.reset();
+            error.reset();
+
+            if (auto opened = db.begin_ro_transaction(); opened) {
+                txn.emplace(std::move(*opened));
+                snapshot_ids[partition] = txn->id();
+            } else {
+                error = opened.error();
+                snapshot_ids[partition] = 0;
+            }
+
+            sync.arrive_and_wait();
+            if (same_snapshot || attempts > options.snapshot_retries)
+                break;
+        }
+
+        if (error) {
+            partials[partition] = std::unexpected{*error};
+            return;
+        }
+
+        auto const *const lower
+            = partition > 0 ? &boundaries[partition - 1] : nullptr;
+        auto const *const upper = partition < boundaries.size()
+                                      ? &boundaries[partition]
+                                      : nullptr;
+        try {
+            partials[partition]
+                = details::scan_partition<Result>(*txn, lower, upper, map);
+        } catch (...) {
+            exceptions[partition] = std::current_exception();
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(partition_count);
+        for (size_t i = 0; i < partition_count; ++i)
+            workers.emplace_back(scan, i);
+    }
+
+    for (auto const &exception : exceptions) {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+
+    auto result = std::move(init);
+    for (auto &partial : partials) {
+        if (!*partial)
+            return std::unexpected{partial->error()};
+        result = reduce(std::move(result), std::move(**partial));
+    }
+    return result;
+}
+
+// parallel_scan over partition_count partitions of about the same key
+// span, see details::sample_split_points. Requires the bytewise key order
+// of LMDB (or integer keys) and a key_trait::from_bytes accepting any byte
+// string of the key size. Fewer partitions are scanned when the keys are
+// too close together to be split that many times.
+template <
+    key_value_trait KeyValueTrait,
+    lmdb_api_like LmdbApi,
+    typename Result,
+    typename Map,
+    typename Reduce>
+auto parallel_scan(
+    ro_db<KeyValueTrait, LmdbApi> const &db,
+    size_t const partition_count,
+    Result init,
+    Map map,
+    Reduce reduce,
+    parallel_scan_options_t const &options = {})
+    -> std::expected<Result, error_t>
+    requires(
+        !details::key_value_trait_helper<KeyValueTrait>::key_reversed
+        && !details::key_value_trait_helper<KeyValueTrait>::has_key_cmp_fun)
+{
+    auto const boundaries = details::sample_split_points(db, partition_count);
+    if (!boundaries)
+        return std::unexpected{boundaries.error()};
+
+    return parallel_scan(
+        db,
+        std::span{*boundaries},
+        std::move(init),
+        std::move(map),
+        std::move(reduce),
+        options);
+}
+
+}  // namespace lmdb
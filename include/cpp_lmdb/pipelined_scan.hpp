@@ -0,0 +1,162 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/db_item.hpp"
+#include "cpp_lmdb/dbs.hpp"
+#include "cpp_lmdb/error.hpp"
+
+// details
+#include "cpp_lmdb/details/bounded_ring.hpp"
+#include "cpp_lmdb/details/key_value_traits.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <expected>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lmdb
+{
+struct pipelined_scan_options_t {
+    // threads decoding the items and running the callback
+    size_t worker_count{4};
+    // items buffered between the cursor and the workers, rounded up to a
+    // power of two; the cursor waits while the ring is full
+    size_t ring_capacity{1024};
+    // runs the callback for one item at a time in key order, the items are
+    // still decoded in parallel
+    bool ordered{};
+};
+
+// Scans a db with the cursor on the calling thread and the decoding of the
+// items on options.worker_count threads, for values whose from_bytes costs
+// more than walking the tree. The ring carries the raw key and value bytes,
+// which point into the snapshot and stay valid because the transaction is
+// kept open until the workers are done. fn(key_type, value_type) has to be
+// safe to call concurrently unless options.ordered is set. Returns the
+// number of items scanned; an exception thrown by fn or by the traits stops
+// the scan and is rethrown once the workers are joined.
+template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi, typename Fn>
+auto pipelined_scan(
+    ro_db<KeyValueTrait, LmdbApi> const &db,
+    Fn fn,
+    pipelined_scan_options_t const &options = {})
+    -> std::expected<size_t, error_t>
+    requires std::invocable<
+        Fn &,
+        typename KeyValueTrait::key_trait::value_type,
+        typename KeyValueTrait::value_trait::value_type>
+{
+    using item_type = ro_db_item<
+        typename KeyValueTrait::key_trait,
+        typename KeyValueTrait::value_trait>;
+
+    struct pipeline_item {
+        // std::nullopt ends a worker
+        std::optional<item_type> item;
+        size_t index{};
+    };
+
+    auto txn = db.begin_ro_transaction();
+    if (!txn)
+        return std::unexpected{txn.error()};
+
+    auto view = txn->iterate();
+    if (!view)
+        return std::unexpected{view.error()};
+
+    details::bounded_ring<pipeline_item> ring{options.ring_capacity};
+    std::atomic<size_t> next_delivery{};
+    std::atomic<bool> failed{};
+    std::mutex exception_mutex;
+    std::exception_ptr exception;
+
+    auto const fail = [&] {
+        std::lock_guard const lock{exception_mutex};
+        if (!exception)
+            exception = std::current_exception();
+        failed.store(true, std::memory_order_relaxed);
+    };
+
+    auto const work = [&] {
+        while (true) {
+            auto const next = ring.pop();
+            if (!next.item)
+                return;
+
+            std::optional<std::pair<
+                typename item_type::key_type,
+                typename item_type::value_type>>
+                decoded;
+            if (!failed.load(std::memory_order_relaxed)) {
+                try {
+                    decoded.emplace(next.item->key(), next.item->value());
+                } catch (...) {
+                    fail();
+                }
+            }
+
+            if (options.ordered) {
+                for (auto delivery = next_delivery.load(
+                         std::memory_order_acquire);
+                     delivery != next.index;
+                     delivery = next_delivery.load(std::memory_order_acquire))
+                    next_delivery.wait(delivery, std::memory_order_acquire);
+            }
+
+            if (decoded && !failed.load(std::memory_order_relaxed)) {
+                try {
+                    std::invoke(
+                        fn,
+                        std::move(decoded->first),
+                        std::move(decoded->second));
+                } catch (...) {
+                    fail();
+                }
+            }
+
+            if (options.ordered) {
+                next_delivery.store(
+                    next.index + 1, std::memory_order_release);
+                next_delivery.notify_all();
+            }
+        }
+    };
+
+    size_t count{};
+    std::optional<error_t> error;
+    {
+        auto const worker_count = std::max<size_t>(options.worker_count, 1);
+        std::vector<std::jthread> workers;
+        workers.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i)
+            workers.emplace_back(work);
+
+        auto it = view->begin();
+        for (; it != view->end() && !failed.load(std::memory_order_relaxed);
+             ++it)
+            ring.push({*it, count++});
+
+        if (it != view->end() || it.error() != error_t::not_found)
+            error = it.error();
+
+        for (size_t i = 0; i < worker_count; ++i)
+            ring.push({});
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+    if (error)
+        return std::unexpected{*error};
+    return count;
+}
+
+}  // namespace lmdb
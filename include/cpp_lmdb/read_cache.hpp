@@ -0,0 +1,378 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/dbs.hpp"
+#include "cpp_lmdb/error.hpp"
+
+// details
+#include "cpp_lmdb/details/commit_listener.hpp"
+#include "cpp_lmdb/details/key_value_traits.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace lmdb
+{
+struct read_cache_options_t {
+    // shards are locked independently, keys are spread by hash
+    size_t shard_count{16};
+    // approximate memory held by the cached entries, see read_cache
+    size_t byte_budget{size_t{64} << 20U};
+};
+
+struct read_cache_stats_t {
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+    // entries dropped because their key was written, or by clear()
+    size_t invalidations;
+};
+
+namespace details
+{
+struct transparent_string_hash {
+    using is_transparent = void;
+
+    auto operator()(std::string_view const value) const noexcept -> size_t
+    {
+        return std::hash<std::string_view>{}(value);
+    }
+};
+
+// bytes charged to the budget for a cached value: its size plus the
+// elements it owns when it is a contiguous range such as a string
+template <typename T>
+auto cached_value_size(T const &value) noexcept -> size_t
+{
+    if constexpr (std::ranges::contiguous_range<T const>
+                  && std::ranges::sized_range<T const>) {
+        return sizeof(T)
+               + std::ranges::size(value)
+                     * sizeof(std::ranges::range_value_t<T const>);
+    } else {
+        return sizeof(T);
+    }
+}
+}  // namespace details
+
+// Cache of decoded values in front of the ro transactions of a db. Each
+// shard keeps its entries in a CLOCK ring: hits set the referenced bit of
+// an entry and the hand evicts the first unreferenced entry once the shard
+// is over its share of the byte budget (key bytes, cached_value_size and a
+// fixed overhead per entry).
+//
+// Entries are tagged with the id of the snapshot they were read in. A
+// cache built on a rw_db is attached to it as commit listener: the keys a
+// commit wrote are dropped after the commit, and entries read in an older
+// snapshot are not inserted once a newer commit touched their shard. get
+// with a transaction only uses entries not newer than the snapshot of the
+// transaction. Any read snapshot newer than the last commit reported, i.e.
+// a commit from another process or handle, drops the whole cache. get
+// without a transaction is served from the cache without opening one, so
+// it only sees the writes of other handles after a miss or a get with a
+// transaction noticed them.
+template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi>
+    requires(!details::key_value_trait_helper<
+             KeyValueTrait>::duplicates_enabled)
+class read_cache : private details::commit_listener<LmdbApi> {
+public:
+    using db_type = ro_db<KeyValueTrait, LmdbApi>;
+    using ro_transaction = typename db_type::ro_transaction;
+    using key_type = typename KeyValueTrait::key_trait::value_type;
+    using value_type = typename KeyValueTrait::value_trait::value_type;
+
+    explicit read_cache(
+        db_type const &db, read_cache_options_t const &options = {})
+        : _db{db}
+        , _shards(std::max(options.shard_count, size_t{1}))
+        , _shard_budget{options.byte_budget / _shards.size()}
+    {}
+
+    explicit read_cache(
+        rw_db<KeyValueTrait, LmdbApi> &db,
+        read_cache_options_t const &options = {})
+        : read_cache{static_cast<db_type const &>(db), options}
+    {
+        _writer = &db;
+        db.add_commit_listener(this);
+    }
+
+    read_cache(read_cache const &) = delete;
+    auto operator=(read_cache const &) -> read_cache & = delete;
+
+    ~read_cache() override
+    {
+        if (_writer != nullptr)
+            _writer->remove_commit_listener(this);
+    }
+
+    // reads in a transaction of its own on a miss
+    auto get(key_type const &key) -> std::expected<value_type, error_t>
+    {
+        auto const key_bytes = KeyValueTrait::key_trait::to_bytes(key);
+        std::string_view const encoded{
+            reinterpret_cast<char const *>(key_bytes.data()),
+            key_bytes.size()};
+
+        auto &shard = shard_of(encoded);
+        if (auto cached = lookup(shard, encoded, std::nullopt); cached)
+            return std::move(*cached);
+
+        auto const txn = _db.begin_ro_transaction();
+        if (!txn)
+            return std::unexpected{txn.error()};
+
+        observe_snapshot(txn->id());
+        return load(shard, encoded, *txn, key);
+    }
+
+    auto get(ro_transaction const &txn, key_type const &key)
+        -> std::expected<value_type, error_t>
+    {
+        auto const key_bytes = KeyValueTrait::key_trait::to_bytes(key);
+        std::string_view const encoded{
+            reinterpret_cast<char const *>(key_bytes.data()),
+            key_bytes.size()};
+
+        observe_snapshot(txn.id());
+        auto &shard = shard_of(encoded);
+        if (auto cached = lookup(shard, encoded, txn.id()); cached)
+            return std::move(*cached);
+
+        return load(shard, encoded, txn, key);
+    }
+
+    // drops every entry, e.g. after writes the cache was not told about
+    auto clear() -> void
+    {
+        invalidate_all(_last_commit_id.load(std::memory_order_acquire));
+    }
+
+    auto stats() const noexcept -> read_cache_stats_t
+    {
+        return {
+            .hits = _hits.load(std::memory_order_relaxed),
+            .misses = _misses.load(std::memory_order_relaxed),
+            .evictions = _evictions.load(std::memory_order_relaxed),
+            .invalidations = _invalidations.load(std::memory_order_relaxed),
+        };
+    }
+
+private:
+    static constexpr size_t entry_overhead{64};
+
+    struct entry {
+        std::string key;
+        value_type value;
+        size_t txn_id;
+        size_t charge;
+        bool referenced;
+    };
+
+    struct shard {
+        std::mutex mutex;
+        std::unordered_map<
+            std::string,
+            size_t,
+            details::transparent_string_hash,
+            std::equal_to<>>
+            index;
+        std::vector<std::optional<entry>> slots;
+        std::vector<size_t> free_slots;
+        size_t hand{};
+        size_t charged{};
+        // id of the last commit which dropped keys of the shard, entries
+        // read in older snapshots may be stale
+        size_t invalidated_at{};
+    };
+
+    auto shard_of(std::string_view const key) -> shard &
+    {
+        return _shards[details::transparent_string_hash{}(key)
+                       % _shards.size()];
+    }
+
+    auto lookup(
+        shard &shard,
+        std::string_view const key,
+        std::optional<size_t> const snapshot) -> std::optional<value_type>
+    {
+        {
+            std::lock_guard const lock{shard.mutex};
+            if (auto const it = shard.index.find(key);
+                it != shard.index.end()) {
+                auto &cached = *shard.slots[it->second];
+                if (!snapshot || cached.txn_id <= *snapshot) {
+                    cached.referenced = true;
+                    _hits.fetch_add(1, std::memory_order_relaxed);
+                    return cached.value;
+                }
+            }
+        }
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    auto load(
+        shard &shard,
+        std::string_view const key,
+        ro_transaction const &txn,
+        key_type const &decoded_key) -> std::expected<value_type, error_t>
+    {
+        auto value = txn.get(decoded_key);
+        if (value)
+            insert(shard, key, *value, txn.id());
+        return value;
+    }
+
+    auto insert(
+        shard &shard,
+        std::string_view const key,
+        value_type const &value,
+        size_t const txn_id) -> void
+    {
+        auto const charge
+            = key.size() + details::cached_value_size(value) + entry_overhead;
+        if (charge > _shard_budget)
+            return;
+
+        std::lock_guard const lock{shard.mutex};
+        if (txn_id < shard.invalidated_at || shard.index.contains(key))
+            return;
+
+        while (shard.charged + charge > _shard_budget)
+            evict_one(shard);
+
+        size_t slot{};
+        if (shard.free_slots.empty()) {
+            slot = shard.slots.size();
+            shard.slots.emplace_back();
+        } else {
+            slot = shard.free_slots.back();
+            shard.free_slots.pop_back();
+        }
+
+        shard.slots[slot].emplace(
+            entry{std::string{key}, value, txn_id, charge, false});
+        shard.index.emplace(std::string{key}, slot);
+        shard.charged += charge;
+    }
+
+    // second chance: referenced entries are spared once per revolution
+    auto evict_one(shard &shard) -> void
+    {
+        while (true) {
+            shard.hand = (shard.hand + 1) % shard.slots.size();
+            auto &slot = shard.slots[shard.hand];
+            if (!slot)
+                continue;
+            if (slot->referenced) {
+                slot->referenced = false;
+                continue;
+            }
+
+            erase(shard, shard.hand);
+            _evictions.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    auto erase(shard &shard, size_t const slot) -> void
+    {
+        shard.charged -= shard.slots[slot]->charge;
+        shard.index.erase(shard.slots[slot]->key);
+        shard.slots[slot].reset();
+        shard.free_slots.push_back(slot);
+    }
+
+    auto on_commit(
+        size_t const txn_id,
+        details::written_keys_t const *const keys) noexcept -> void override
+    {
+        // the keys are dropped before the commit becomes known, a reader of
+        // the new snapshot arriving in between drops the whole cache rather
+        // than hitting a stale entry
+        if (keys == nullptr)
+            invalidate_all(txn_id);
+        else
+            invalidate(txn_id, *keys);
+
+        auto last = _last_commit_id.load(std::memory_order_relaxed);
+        while (last < txn_id
+               && !_last_commit_id.compare_exchange_weak(
+                   last, txn_id, std::memory_order_acq_rel))
+        {}
+    }
+
+    auto invalidate(size_t const txn_id, details::written_keys_t const &keys)
+        -> void
+    {
+        for (auto const &key : keys) {
+            std::string_view const encoded{
+                reinterpret_cast<char const *>(key.data()), key.size()};
+            auto &shard = shard_of(encoded);
+
+            std::lock_guard const lock{shard.mutex};
+            shard.invalidated_at = std::max(shard.invalidated_at, txn_id);
+            if (auto const it = shard.index.find(encoded);
+                it != shard.index.end()) {
+                erase(shard, it->second);
+                _invalidations.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    auto observe_snapshot(size_t const txn_id) -> void
+    {
+        auto last = _last_commit_id.load(std::memory_order_acquire);
+        while (last < txn_id) {
+            if (_last_commit_id.compare_exchange_weak(
+                    last, txn_id, std::memory_order_acq_rel)) {
+                invalidate_all(txn_id);
+                return;
+            }
+        }
+    }
+
+    auto invalidate_all(size_t const txn_id) -> void
+    {
+        for (auto &shard : _shards) {
+            std::lock_guard const lock{shard.mutex};
+            shard.invalidated_at = std::max(shard.invalidated_at, txn_id);
+            _invalidations.fetch_add(
+                shard.index.size(), std::memory_order_relaxed);
+            shard.index.clear();
+            shard.slots.clear();
+            shard.free_slots.clear();
+            shard.hand = 0;
+            shard.charged = 0;
+        }
+    }
+
+    db_type const &_db;
+    rw_db<KeyValueTrait, LmdbApi> *_writer{};
+    std::vector<shard> _shards;
+    size_t const _shard_budget;
+    // id of the newest snapshot known to the cache
+    std::atomic<size_t> _last_commit_id{};
+
+    std::atomic<size_t> _hits{};
+    std::atomic<size_t> _misses{};
+    std::atomic<size_t> _evictions{};
+    std::atomic<size_t> _invalidations{};
+};
+
+}  // namespace lmdb
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "cpp_lmdb/error.hpp"
+
+// lmdb
+#include "lmdb.h"
+
+// std
+#include <cstddef>
+#include <expected>
+
+namespace lmdb
+{
+// B-tree statistics of a db (mdb_stat), or of the main db of an
+// environment (mdb_env_stat)
+struct db_stats_t {
+    size_t page_size;
+    size_t depth;
+    size_t branch_pages;
+    size_t leaf_pages;
+    size_t overflow_pages;
+    // items, i.e. every duplicate of a key counts
+    size_t entries;
+};
+
+// map usage and reader slots of an environment (mdb_env_info)
+struct env_info_t {
+    size_t map_size;
+    size_t page_size;
+    size_t last_page;
+    size_t last_txn_id;
+    size_t max_readers;
+    size_t used_readers;
+
+    // bytes of the map up to the last page used
+    auto used_size() const noexcept -> size_t
+    {
+        return (last_page + 1) * page_size;
+    }
+};
+
+namespace details
+{
+inline auto to_db_stats(MDB_stat const &stat) noexcept -> db_stats_t
+{
+    return {
+        .page_size = stat.ms_psize,
+        .depth = stat.ms_depth,
+        .branch_pages = stat.ms_branch_pages,
+        .leaf_pages = stat.ms_leaf_pages,
+        .overflow_pages = stat.ms_overflow_pages,
+        .entries = stat.ms_entries,
+    };
+}
+
+template <typename LmdbApi>
+auto db_stats(LmdbApi const &api, MDB_txn *const txn, MDB_dbi const db_index)
+    -> std::expected<db_stats_t, error_t>
+{
+    MDB_stat stat{};
+    if (auto const result = api.mdb_stat(txn, db_index, &stat);
+        result != MDB_SUCCESS)
+        return std::unexpected{error_t{result}};
+
+    return to_db_stats(stat);
+}
+
+template <typename LmdbApi>
+auto env_stats(LmdbApi const &api, MDB_env &env)
+    -> std::expected<db_stats_t, error_t>
+{
+    MDB_stat stat{};
+    if (auto const result = api.mdb_env_stat(&env, &stat);
+        result != MDB_SUCCESS)
+        return std::unexpected{error_t{result}};
+
+    return to_db_stats(stat);
+}
+
+template <typename LmdbApi>
+auto env_info(LmdbApi const &api, MDB_env &env)
+    -> std::expected<env_info_t, error_t>
+{
+    MDB_envinfo info{};
+    if (auto const result = api.mdb_env_info(&env, &info);
+        result != MDB_SUCCESS)
+        return std::unexpected{error_t{result}};
+
+    auto const stats = env_stats(api, env);
+    if (!stats)
+        return std::unexpected{stats.error()};
+
+    return env_info_t{
+        .map_size = info.me_mapsize,
+        .page_size = stats->page_size,
+        .last_page = info.me_last_pgno,
+        .last_txn_id = info.me_last_txnid,
+        .max_readers = info.me_maxreaders,
+        .used_readers = info.me_numreaders,
+    };
+}
+}  // namespace details
+
+}  // namespace lmdb
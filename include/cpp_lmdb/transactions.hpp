@@ -3,10 +3,12 @@
 #include "cpp_lmdb/concepts.hpp"
 #include "cpp_lmdb/db_item.hpp"
 #include "cpp_lmdb/iterators.hpp"
+#include "cpp_lmdb/stats.hpp"
 #include "cpp_lmdb/views.hpp"
 #include "cpp_lmdb/types.hpp"
 
 // details
+#include "cpp_lmdb/details/commit_listener.hpp"
 #include "cpp_lmdb/details/details.hpp"
 #include "cpp_lmdb/details/key_value_traits.hpp"
 
@@ -14,20 +16,46 @@
 #include "lmdb.h"
 
 // std
+#include <algorithm>
+#include <array>
 #include <concepts>
 #include <expected>
+#include <memory>
+#include <new>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace lmdb
 {
 template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi>
 class rw_db;
 
+template <
+    read_only_t ReadOnly,
+    lmdb_api_like LmdbApi,
+    key_value_trait... KeyValueTraits>
+class multi_transaction;
+
+namespace details
+{
+template <typename LmdbApi>
+struct txn_holder {
+    txn_unique_ptr_t<LmdbApi> _txn;
+};
+
+// Typed operations on a single db within a transaction that is owned
+// elsewhere, see transaction and multi_transaction.
 template <
     key_value_trait KeyValueTrait,
     read_only_t ReadOnly,
     lmdb_api_like LmdbApi>
-class transaction {
-    friend class rw_db<KeyValueTrait, LmdbApi>;
+class transaction_base {
+    template <read_only_t, lmdb_api_like, key_value_trait...>
+    friend class lmdb::multi_transaction;
 
 public:
     using key_trait = typename KeyValueTrait::key_trait;
@@ -42,14 +70,37 @@ public:
         ro_dup_iterator<key_trait, value_trait, LmdbApi>,
         LmdbApi>;
 
+    using key_view_type = details::borrowed_trait<key_trait>::value_type;
+    using value_view_type = details::borrowed_trait<value_trait>::value_type;
+
+    using ro_range_view = db_range_view<
+        ro_range_iterator<key_trait, value_trait, LmdbApi>,
+        LmdbApi>;
+
+    using ro_page_view
+        = db_dup_view<ro_page_iterator<value_trait, LmdbApi>, LmdbApi>;
+
+    using ro_borrowed_view = db_view<
+        ro_iterator<
+            details::borrowed_trait<key_trait>,
+            details::borrowed_trait<value_trait>,
+            LmdbApi>,
+        LmdbApi>;
+
 public:
-    transaction(
-        MDB_dbi const db_index, details::txn_unique_ptr_t<LmdbApi> &&txn) noexcept
+    transaction_base(
+        MDB_dbi const db_index,
+        MDB_txn *const txn,
+        LmdbApi const &api,
+        details::cursor_cache<LmdbApi> *cursor_cache = nullptr) noexcept
         : _db_index{db_index}
-        , _txn{std::move(txn)}
-        , _api{_txn.get_deleter().api}
+        , _txn{txn}
+        , _api{api}
+        , _cursor_cache{cursor_cache}
     {}
 
+    transaction_base(transaction_base &&) noexcept = default;
+
     auto try_insert(key_type const &key, value_type const &value) noexcept
         -> std::expected<void, error_t>
         requires(ReadOnly == read_only_t::no)
@@ -75,6 +126,87 @@ public:
         return insert_impl(key, value, 0);
     }
 
+    // Stores a contiguous array of duplicates of an MDB_DUPFIXED db with
+    // MDB_MULTIPLE, returns the number of values written. Values of traits
+    // storing them in their native layout are passed in place, others are
+    // encoded a page at a time.
+    auto insert_multiple(
+        key_type const &key, std::span<value_type const> const values) noexcept
+        -> std::expected<size_t, error_t>
+        requires(
+            ReadOnly == read_only_t::no
+            && details::key_value_trait_helper<
+                KeyValueTrait>::value_fixed_size
+            && details::key_value_trait_helper<
+                KeyValueTrait>::duplicates_enabled)
+    {
+        if (values.empty())
+            return 0;
+
+        auto cursor = make_cursor();
+        if (!cursor)
+            return std::unexpected{error_t{cursor.error()}};
+
+        auto const key_bytes = key_trait::to_bytes(key);
+        auto mdb_key = details::to_mdb_val(key_bytes);
+
+        auto const put_multiple = [&](void *const data,
+                                      size_t const value_size,
+                                      size_t const count)
+            -> std::expected<size_t, error_t> {
+            std::array<MDB_val, 2> mdb_values{
+                MDB_val{value_size, data}, MDB_val{count, nullptr}};
+            if (auto const result = _api.mdb_cursor_put(
+                    cursor->get(),
+                    &mdb_key,
+                    mdb_values.data(),
+                    MDB_MULTIPLE);
+                result != MDB_SUCCESS) {
+                return std::unexpected{error_t{result}};
+            }
+            return mdb_values[1].mv_size;
+        };
+
+        size_t written{};
+        if constexpr (details::has_native_layout_v<value_trait>) {
+            auto const result = put_multiple(
+                const_cast<value_type *>(values.data()),
+                sizeof(value_type),
+                values.size());
+            if (!result)
+                return result;
+            written = *result;
+        } else {
+            // MDB_DUPFIXED values are at most the maximum key size
+            constexpr size_t page_size{4096};
+            std::array<std::byte, page_size> page;
+
+            auto const value_size
+                = value_trait::to_bytes(values.front()).size();
+            auto const page_capacity
+                = page_size / std::max(value_size, size_t{1});
+            for (auto remaining = values; !remaining.empty();) {
+                auto const chunk = remaining.first(
+                    std::min(remaining.size(), page_capacity));
+                for (size_t index = 0; index < chunk.size(); ++index) {
+                    auto const bytes = value_trait::to_bytes(chunk[index]);
+                    std::ranges::copy(
+                        bytes, page.begin() + index * value_size);
+                }
+
+                auto const result
+                    = put_multiple(page.data(), value_size, chunk.size());
+                if (!result)
+                    return result;
+                written += *result;
+                remaining = remaining.subspan(chunk.size());
+            }
+        }
+
+        record_written_key(mdb_key);
+        return written;
+    }
+
     auto delete_key(key_type const &key) noexcept
         -> std::expected<void, error_t>
     {
@@ -82,11 +214,36 @@ public:
         auto mdb_key = to_mdb_val(key_bytes);
 
         if (auto const result
-            = _api.mdb_del(_txn.get(), _db_index, &mdb_key, nullptr);
+            = _api.mdb_del(_txn, _db_index, &mdb_key, nullptr);
+            result != MDB_SUCCESS) {
+            return std::unexpected{error_t{result}};
+        }
+
+        record_written_key(mdb_key);
+        return {};
+    }
+
+    // deletes a single duplicate of the key, the others are kept
+    auto delete_duplicate(
+        key_type const &key, value_type const &value) noexcept
+        -> std::expected<void, error_t>
+        requires(
+            ReadOnly == read_only_t::no
+            && details::key_value_trait_helper<
+                KeyValueTrait>::duplicates_enabled)
+    {
+        auto const key_bytes = key_trait::to_bytes(key);
+        auto mdb_key = details::to_mdb_val(key_bytes);
+        auto const value_bytes = value_trait::to_bytes(value);
+        auto mdb_value = details::to_mdb_val(value_bytes);
+
+        if (auto const result
+            = _api.mdb_del(_txn, _db_index, &mdb_key, &mdb_value);
             result != MDB_SUCCESS) {
             return std::unexpected{error_t{result}};
         }
 
+        record_written_key(mdb_key);
         return {};
     }
 
@@ -100,31 +257,217 @@ public:
         MDB_val mdb_value{};
 
         if (auto const result
-            = _api.mdb_get(_txn.get(), _db_index, &mdb_key, &mdb_value);
+            = _api.mdb_get(_txn, _db_index, &mdb_key, &mdb_value);
             result != MDB_SUCCESS) {
             return std::unexpected{error_t{result}};
         }
 
-        return value_trait::from_bytes(details::to_byte_span(mdb_value));
+        return details::decode_value<value_trait>(
+            details::to_byte_span(mdb_value));
     }
 
+    // Looks up all keys with a single cursor walking them in the order of
+    // the db comparator, which keeps neighbouring keys on already visited
+    // pages. results[i] receives the outcome for keys[i]; results must hold
+    // at least as many elements as keys, otherwise invalid_argument is
+    // returned.
+    template <std::ranges::random_access_range Keys>
+    auto get_many(
+        Keys const &keys,
+        std::span<std::expected<value_type, error_t>> const results) const
+        -> std::expected<void, error_t>
+        requires(
+            !details::key_value_trait_helper<
+                KeyValueTrait>::duplicates_enabled
+            && std::same_as<std::ranges::range_value_t<Keys>, key_type>
+            && std::is_lvalue_reference_v<
+                std::ranges::range_reference_t<Keys const>>)
+    {
+        auto const count = static_cast<size_t>(std::ranges::size(keys));
+        if (results.size() < count)
+            return std::unexpected{error_t::invalid_argument};
+
+        if (count == 0)
+            return {};
+
+        // keys encoded as spans refer to the caller's keys, only the lookup
+        // order is allocated; owned encodings are kept for the walk
+        using encoded_type
+            = decltype(key_trait::to_bytes(std::declval<key_type const &>()));
+        constexpr bool owned_encoding
+            = !std::same_as<encoded_type, std::span<std::byte const>>;
+
+        std::vector<encoded_type> encoded;
+        if constexpr (owned_encoding)
+            encoded.reserve(count);
+
+        std::vector<std::pair<MDB_val, size_t>> lookups;
+        lookups.reserve(count);
+        for (size_t index = 0; index < count; ++index) {
+            auto bytes = key_trait::to_bytes(std::ranges::begin(keys)[index]);
+            if constexpr (owned_encoding) {
+                encoded.push_back(std::move(bytes));
+                lookups.emplace_back(
+                    details::to_mdb_val(encoded.back()), index);
+            } else {
+                lookups.emplace_back(details::to_mdb_val(bytes), index);
+            }
+        }
+
+        std::ranges::sort(lookups, [this](auto const &lhs, auto const &rhs) {
+            return _api.mdb_cmp(_txn, _db_index, &lhs.first, &rhs.first) < 0;
+        });
+
+        auto cursor = make_cursor();
+        if (!cursor)
+            return std::unexpected{error_t{cursor.error()}};
+
+        for (auto &[mdb_key, index] : lookups) {
+            MDB_val mdb_value{};
+            if (auto const result = _api.mdb_cursor_get(
+                    cursor->get(), &mdb_key, &mdb_value, MDB_SET_KEY);
+                result != MDB_SUCCESS) {
+                results[index] = std::unexpected{error_t{result}};
+            } else {
+                results[index] = details::decode_value<value_trait>(
+                    details::to_byte_span(mdb_value));
+            }
+        }
+
+        return {};
+    }
+
+    // Zero-copy counterpart of get: the view points into the map and is
+    // only valid while the transaction is alive.
+    auto get_view(key_type const &key) const & noexcept CPP_LMDB_LIFETIMEBOUND
+        -> std::expected<value_view_type, error_t>
+        requires(!details::key_value_trait_helper<
+                 KeyValueTrait>::duplicates_enabled)
+    {
+        auto const key_bytes = key_trait::to_bytes(key);
+        auto mdb_key = details::to_mdb_val(key_bytes);
+        MDB_val mdb_value{};
+
+        if (auto const result
+            = _api.mdb_get(_txn, _db_index, &mdb_key, &mdb_value);
+            result != MDB_SUCCESS) {
+            return std::unexpected{error_t{result}};
+        }
+
+        return details::borrowed_trait<value_trait>::from_bytes(
+            details::to_byte_span(mdb_value));
+    }
+
+    auto get_view(key_type const &key) const && = delete;
+
     // TODO: probably, if exceptions are not enabled, iterator should be
     // returned instead of view as error reporting from views will be limited
     auto iterate() const noexcept -> std::expected<ro_view, error_t>
     {
-        auto cursor = details::make_cursor(_api, _txn.get(), _db_index);
+        auto cursor = make_cursor();
         if (!cursor)
             return std::unexpected{error_t{cursor.error()}};
 
         return ro_view{std::move(*cursor)};
     }
 
+    // iterates over the items with keys not less than key
+    auto iterate_from(key_type const &key) const noexcept
+        -> std::expected<ro_range_view, error_t>
+    {
+        return iterate_range_impl(direction_t::forward, &key, nullptr);
+    }
+
+    // iterates over the items with keys less than key
+    auto iterate_to(key_type const &key) const noexcept
+        -> std::expected<ro_range_view, error_t>
+    {
+        return iterate_range_impl(direction_t::forward, nullptr, &key);
+    }
+
+    // iterates over the items with keys in [lower, upper) in the order of
+    // the db comparator
+    auto iterate_range(
+        key_type const &lower, key_type const &upper) const noexcept
+        -> std::expected<ro_range_view, error_t>
+    {
+        return iterate_range_impl(direction_t::forward, &lower, &upper);
+    }
+
+    // Iterates over the items whose encoded keys start with the encoded
+    // prefix. Requires the bytewise key order of LMDB, i.e. a trait without
+    // reversed_flag or cmp, whose encoding preserves the order of values.
+    auto iterate_prefix(key_type const &prefix) const noexcept
+        -> std::expected<ro_range_view, error_t>
+        requires(
+            !details::key_value_trait_helper<KeyValueTrait>::key_reversed
+            && !details::key_value_trait_helper<
+                KeyValueTrait>::has_key_cmp_fun
+            && !details::key_value_trait_helper<
+                KeyValueTrait>::is_integer_key)
+    {
+        // LMDB rejects empty keys, an empty prefix starts from the first key
+        auto const prefix_bytes = key_trait::to_bytes(prefix);
+        return iterate_range_impl(
+            direction_t::forward,
+            prefix_bytes.empty() ? nullptr : &prefix,
+            nullptr,
+            std::vector<std::byte>{prefix_bytes.begin(), prefix_bytes.end()});
+    }
+
+    // Iterates over the items whose keys start with the given leading
+    // components, for key traits encoding them separately, see
+    // tuple_key_trait.
+    template <typename... Leading>
+    auto iterate_prefix(Leading const &...leading) const noexcept
+        -> std::expected<ro_range_view, error_t>
+        requires requires { key_trait::prefix_to_bytes(leading...); }
+    {
+        auto prefix_bytes = key_trait::prefix_to_bytes(leading...);
+        auto lower = prefix_bytes.empty()
+                         ? std::nullopt
+                         : std::optional<std::vector<std::byte>>{prefix_bytes};
+        return iterate_bytes_range(
+            direction_t::forward,
+            std::move(lower),
+            std::nullopt,
+            std::move(prefix_bytes));
+    }
+
+    auto iterate_reverse() const noexcept
+        -> std::expected<ro_range_view, error_t>
+    {
+        return iterate_range_impl(direction_t::reverse, nullptr, nullptr);
+    }
+
+    // iterates over the items with keys in [lower, upper) from the last one
+    auto iterate_range_reverse(
+        key_type const &lower, key_type const &upper) const noexcept
+        -> std::expected<ro_range_view, error_t>
+    {
+        return iterate_range_impl(direction_t::reverse, &lower, &upper);
+    }
+
+    // iterates over items yielding key_view_type and value_view_type, which
+    // are only valid while the transaction is alive
+    auto iterate_views() const & noexcept CPP_LMDB_LIFETIMEBOUND
+        -> std::expected<ro_borrowed_view, error_t>
+    {
+        auto cursor = make_cursor();
+        if (!cursor)
+            return std::unexpected{error_t{cursor.error()}};
+
+        return ro_borrowed_view{std::move(*cursor)};
+    }
+
+    auto iterate_views() const && = delete;
+
     auto iterate_by_key(key_type const &key) const noexcept
         -> std::expected<ro_dup_view, error_t>
         requires(
             details::key_value_trait_helper<KeyValueTrait>::duplicates_enabled)
     {
-        auto cursor = details::make_cursor(_api, _txn.get(), _db_index);
+        auto cursor = make_cursor();
         if (!cursor)
             return std::unexpected{error_t{cursor.error()}};
 
@@ -132,38 +475,293 @@ public:
         return ro_dup_view{std::move(*cursor), key_bytes};
     }
 
-private:
+    // iterates over the duplicates of a key a page at a time, the pages are
+    // only valid while the transaction is alive
+    auto iterate_pages_by_key(key_type const &key) const & noexcept
+        -> std::expected<ro_page_view, error_t>
+        requires(
+            details::key_value_trait_helper<KeyValueTrait>::value_fixed_size
+            && details::key_value_trait_helper<
+                KeyValueTrait>::duplicates_enabled)
+    {
+        auto cursor = make_cursor();
+        if (!cursor)
+            return std::unexpected{error_t{cursor.error()}};
+
+        auto const key_bytes = key_trait::to_bytes(key);
+        return ro_page_view{std::move(*cursor), key_bytes};
+    }
+
+    // id of the snapshot the transaction reads
+    auto id() const noexcept -> size_t
+    {
+        return _api.mdb_txn_id(_txn);
+    }
+
+    // statistics of the db as the transaction sees it, i.e. including its
+    // own uncommitted writes
+    auto stats() const noexcept -> std::expected<db_stats_t, error_t>
+    {
+        return details::db_stats(_api, _txn, _db_index);
+    }
+
+    // number of items of the db, read from its record in O(1)
+    auto size() const noexcept -> std::expected<size_t, error_t>
+    {
+        auto const stats = this->stats();
+        if (!stats)
+            return std::unexpected{stats.error()};
+
+        return stats->entries;
+    }
+
+protected:
     auto insert_impl(
         key_type const &key, value_type const &value, unsigned int flags)
         -> std::expected<void, error_t>
     {
         const auto key_bytes = key_trait::to_bytes(key);
         auto mdb_key = details::to_mdb_val(key_bytes);
+
+        // values are encoded directly into the page reserved by LMDB, which
+        // does not support MDB_RESERVE for sorted duplicates
+        if constexpr (
+            details::has_serialize_into_v<value_trait>
+            && !details::key_value_trait_helper<
+                KeyValueTrait>::duplicates_enabled) {
+            MDB_val mdb_value{value_trait::serialized_size(value), nullptr};
+            if (auto const result = _api.mdb_put(
+                    _txn,
+                    _db_index,
+                    &mdb_key,
+                    &mdb_value,
+                    flags | MDB_RESERVE);
+                result != MDB_SUCCESS) {
+                return std::unexpected{error_t{result}};
+            }
+
+            value_trait::serialize_into(
+                value,
+                std::span{
+                    static_cast<std::byte *>(mdb_value.mv_data),
+                    mdb_value.mv_size});
+            record_written_key(mdb_key);
+            return {};
+        }
+
         const auto value_bytes = value_trait::to_bytes(value);
         auto mdb_value = details::to_mdb_val(value_bytes);
 
         if (auto const result
-            = _api.mdb_put(_txn.get(), _db_index, &mdb_key, &mdb_value, flags);
+            = _api.mdb_put(_txn, _db_index, &mdb_key, &mdb_value, flags);
             result != MDB_SUCCESS) {
             return std::unexpected{error_t{result}};
         }
 
+        record_written_key(mdb_key);
         return {};
     }
 
-    auto commit() && noexcept -> std::expected<void, error_t>
+    auto iterate_range_impl(
+        direction_t const direction,
+        key_type const *const lower,
+        key_type const *const upper,
+        std::optional<std::vector<std::byte>> prefix = std::nullopt) const
+        -> std::expected<ro_range_view, error_t>
     {
-        if (auto const result = commit_tx(_api, std::move(_txn)); !result) {
-            return std::unexpected{error_t{result.error()}};
+        auto const to_bound = [](key_type const *const key)
+            -> std::optional<std::vector<std::byte>> {
+            if (key == nullptr)
+                return std::nullopt;
+
+            auto const bytes = key_trait::to_bytes(*key);
+            return std::vector<std::byte>{bytes.begin(), bytes.end()};
+        };
+
+        return iterate_bytes_range(
+            direction, to_bound(lower), to_bound(upper), std::move(prefix));
+    }
+
+    auto iterate_bytes_range(
+        direction_t const direction,
+        std::optional<std::vector<std::byte>> lower,
+        std::optional<std::vector<std::byte>> upper,
+        std::optional<std::vector<std::byte>> prefix) const
+        -> std::expected<ro_range_view, error_t>
+    {
+        auto cursor = make_cursor();
+        if (!cursor)
+            return std::unexpected{error_t{cursor.error()}};
+
+        return ro_range_view{
+            std::move(*cursor),
+            details::cursor_range{
+                _txn,
+                _db_index,
+                direction,
+                details::key_value_trait_helper<
+                    KeyValueTrait>::duplicates_enabled,
+                std::move(lower),
+                std::move(upper),
+                std::move(prefix)}};
+    }
+
+    auto make_cursor() const
+        -> std::expected<details::cursor_unique_ptr_t<LmdbApi>, int>
+    {
+        if (_cursor_cache == nullptr) {
+            _own_cursor_cache
+                = std::make_unique<details::cursor_cache<LmdbApi>>(
+                    _api, ReadOnly);
+            _cursor_cache = _own_cursor_cache.get();
         }
 
-        return {};
+        return details::make_cursor(_api, _txn, _db_index, *_cursor_cache);
+    }
+
+    auto db_index() const noexcept -> MDB_dbi
+    {
+        return _db_index;
+    }
+
+    // write cursors have to be closed before the transaction ends
+    auto release_cursors() noexcept -> void
+    {
+        _own_cursor_cache.reset();
+        _cursor_cache = nullptr;
+    }
+
+    auto record_written_key(MDB_val const &key) noexcept -> void
+    {
+        if (_written_keys == nullptr || !_written_keys->complete)
+            return;
+
+        try {
+            auto const bytes = details::to_byte_span(key);
+            _written_keys->keys.emplace_back(bytes.begin(), bytes.end());
+        } catch (std::bad_alloc const &) {
+            // listeners then treat the written keys as unknown
+            _written_keys->complete = false;
+            _written_keys->keys = {};
+        }
+    }
+
+    // keys written through this accessor are appended to written_keys
+    auto set_written_keys(
+        details::written_keys_record *const written_keys) noexcept -> void
+    {
+        _written_keys = written_keys;
+    }
+
+    auto recorded_keys() const noexcept -> details::written_keys_record *
+    {
+        return _written_keys;
+    }
+
+    // null if not recorded or incomplete
+    auto written_keys() const noexcept -> written_keys_t const *
+    {
+        if (_written_keys == nullptr || !_written_keys->complete)
+            return nullptr;
+        return &_written_keys->keys;
     }
 
 private:
     MDB_dbi const _db_index;
-    details::txn_unique_ptr_t<LmdbApi> _txn;
+    MDB_txn *_txn;
     LmdbApi const &_api;
+    mutable details::cursor_cache<LmdbApi> *_cursor_cache;
+    mutable std::unique_ptr<details::cursor_cache<LmdbApi>> _own_cursor_cache;
+    details::written_keys_record *_written_keys{};
+};
+}  // namespace details
+
+// The transaction owner is the first base, so cached cursors are closed
+// before the transaction ends.
+template <
+    key_value_trait KeyValueTrait,
+    read_only_t ReadOnly,
+    lmdb_api_like LmdbApi>
+class transaction
+    : private details::txn_holder<LmdbApi>
+    , public details::transaction_base<KeyValueTrait, ReadOnly, LmdbApi> {
+    friend class rw_db<KeyValueTrait, LmdbApi>;
+
+    using holder = details::txn_holder<LmdbApi>;
+    using base = details::transaction_base<KeyValueTrait, ReadOnly, LmdbApi>;
+
+public:
+    transaction(
+        MDB_dbi const db_index,
+        details::txn_unique_ptr_t<LmdbApi> &&txn,
+        details::cursor_cache<LmdbApi> *cursor_cache = nullptr) noexcept
+        : holder{std::move(txn)}
+        , base{
+              db_index,
+              holder::_txn.get(),
+              holder::_txn.get_deleter().api,
+              cursor_cache}
+    {}
+
+    transaction(transaction &&) noexcept = default;
+
+    // Nested transaction (savepoint). The parent must not be used until the
+    // nested transaction is merged or destroyed, the latter discards its
+    // changes. Not supported by environments opened with write_map.
+    auto begin_nested() noexcept -> std::expected<transaction, error_t>
+        requires(ReadOnly == read_only_t::no)
+    {
+        auto &api = holder::_txn.get_deleter().api;
+        auto txn = details::make_tx(
+            api,
+            *api.mdb_txn_env(holder::_txn.get()),
+            ReadOnly,
+            holder::_txn.get());
+        if (!txn)
+            return std::unexpected{error_t{txn.error()}};
+
+        // keys written by a discarded nested transaction are reported too,
+        // which only costs extra invalidations
+        transaction nested{base::db_index(), std::move(txn.value())};
+        nested.set_written_keys(base::recorded_keys());
+        return nested;
+    }
+
+    auto merge_nested(transaction &&nested) noexcept
+        -> std::expected<void, error_t>
+        requires(ReadOnly == read_only_t::no)
+    {
+        return std::move(nested).commit();
+    }
+
+private:
+    auto handle() const noexcept -> MDB_txn *
+    {
+        return holder::_txn.get();
+    }
+
+    // records the keys written by the transaction for the commit listeners
+    // of its db
+    auto track_written_keys() -> void
+    {
+        _own_written_keys = std::make_unique<details::written_keys_record>();
+        base::set_written_keys(_own_written_keys.get());
+    }
+
+    auto commit() && noexcept -> std::expected<void, error_t>
+    {
+        base::release_cursors();
+
+        auto &api = holder::_txn.get_deleter().api;
+        if (auto const result = commit_tx(api, std::move(holder::_txn));
+            !result) {
+            return std::unexpected{error_t{result.error()}};
+        }
+
+        return {};
+    }
+
+    std::unique_ptr<details::written_keys_record> _own_written_keys;
 };
 
 }  // namespace lmdb
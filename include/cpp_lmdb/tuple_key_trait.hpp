@@ -0,0 +1,110 @@
+#pragma once
+
+// details
+#include "cpp_lmdb/details/key_value_traits.hpp"
+#include "cpp_lmdb/details/ordered_encoding.hpp"
+
+// std
+#include <cstddef>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace lmdb
+{
+
+// Component of a tuple_key_trait sorted in descending order.
+template <typename T>
+struct descending {
+    using type = T;
+};
+
+namespace details
+{
+template <typename T>
+struct tuple_component {
+    using type = T;
+    static constexpr std::byte mask{0x00};
+};
+
+template <typename T>
+struct tuple_component<descending<T>> {
+    using type = T;
+    static constexpr std::byte mask{0xFF};
+};
+
+template <typename T>
+concept tuple_key_component
+    = ordered_encodable<typename tuple_component<T>::type>;
+
+template <typename Component, typename Value>
+auto encode_component(Value const &value, std::vector<std::byte> &bytes)
+    -> void
+{
+    using component = tuple_component<Component>;
+    ordered_codec<typename component::type>::encode(
+        value, bytes, component::mask);
+}
+
+template <typename Component>
+auto decode_component(std::span<std::byte const> &bytes) ->
+    typename tuple_component<Component>::type
+{
+    using component = tuple_component<Component>;
+    return ordered_codec<typename component::type>::decode(
+        bytes, component::mask);
+}
+}  // namespace details
+
+// Key trait for composite keys, e.g. tuple_key_trait<uint32_t,
+// descending<int64_t>, std::string>. Each component is encoded so that the
+// memcmp order of the keys is the lexicographic order of the tuples:
+// big-endian unsigned integers, signed integers with the sign bit flipped,
+// floating point numbers in IEEE-754 total order and escaped, terminated
+// strings; descending<T> inverts the bytes of a component. LMDB's default
+// comparator then orders the keys without calling back through a custom
+// cmp, and iterate_prefix accepts the leading components of a key.
+template <details::tuple_key_component... Components>
+    requires(sizeof...(Components) > 0)
+struct tuple_key_trait {
+    using value_type
+        = std::tuple<typename details::tuple_component<Components>::type...>;
+
+    static auto to_bytes(value_type const &value) -> std::vector<std::byte>
+    {
+        return std::apply(
+            [](auto const &...components) {
+                return prefix_to_bytes(components...);
+            },
+            value);
+    }
+
+    static auto from_bytes(std::span<std::byte const> const &bytes)
+        -> value_type
+    {
+        auto remaining = bytes;
+        // the elements of a braced initializer are evaluated in order
+        return value_type{
+            details::decode_component<Components>(remaining)...};
+    }
+
+    // encodes the leading components of a key, the keys starting with them
+    // start with the returned bytes
+    template <typename... Leading>
+        requires(sizeof...(Leading) <= sizeof...(Components))
+    static auto prefix_to_bytes(Leading const &...leading)
+        -> std::vector<std::byte>
+    {
+        std::vector<std::byte> bytes;
+        [&]<size_t... Index>(std::index_sequence<Index...>) {
+            (details::encode_component<
+                 std::tuple_element_t<Index, std::tuple<Components...>>>(
+                 leading, bytes),
+             ...);
+        }(std::index_sequence_for<Leading...>{});
+        return bytes;
+    }
+};
+
+}  // namespace lmdb
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/types.hpp"
+
+// details
+#include "cpp_lmdb/details/details.hpp"
+
+// lmdb
+#include "lmdb.h"
+
+// std
+#include <atomic>
+#include <cstddef>
+#include <expected>
+#include <mutex>
+#include <vector>
+
+namespace lmdb
+{
+
+struct ro_txn_pool_stats_t {
+    size_t hits{};
+    size_t misses{};
+};
+
+// Keeps released read-only transactions in the reset state and renews them
+// on the next acquisition instead of allocating a new MDB_txn.
+// A pool used by several threads requires an environment opened with
+// env_flags_t::no_tls, otherwise one pool per thread should be used.
+// The pool must outlive all transactions acquired from it.
+template <typename LmdbApi>
+class ro_txn_pool {
+public:
+    ro_txn_pool(
+        LmdbApi const &api,
+        MDB_env &env,
+        size_t const capacity,
+        details::map_resize_guard *const resize_guard = nullptr)
+        : _api{api}
+        , _env{env}
+        , _capacity{capacity}
+        , _resize_guard{resize_guard}
+    {
+        _idle.reserve(capacity);
+    }
+
+    ro_txn_pool(ro_txn_pool const &) = delete;
+    auto operator=(ro_txn_pool const &) -> ro_txn_pool & = delete;
+
+    ~ro_txn_pool()
+    {
+        for (auto *txn : _idle)
+            _api.mdb_txn_abort(txn);
+    }
+
+    auto acquire() -> std::expected<details::txn_unique_ptr_t<LmdbApi>, int>
+    {
+        details::map_resize_lock_t resize_lock;
+        if (_resize_guard != nullptr)
+            resize_lock = details::map_resize_lock_t{_resize_guard->mutex};
+
+        while (auto *txn = pop_idle()) {
+            if (_api.mdb_txn_renew(txn) == MDB_SUCCESS) {
+                _hits.fetch_add(1, std::memory_order_relaxed);
+                return details::txn_unique_ptr_t<LmdbApi>{
+                    txn,
+                    details::txn_deleter<LmdbApi>{
+                        _api, this, std::move(resize_lock)}};
+            }
+
+            _api.mdb_txn_abort(txn);
+        }
+
+        _misses.fetch_add(1, std::memory_order_relaxed);
+
+        auto txn = details::make_tx(_api, _env, read_only_t::yes);
+        if (!txn)
+            return std::unexpected{txn.error()};
+
+        return details::txn_unique_ptr_t<LmdbApi>{
+            txn->release(),
+            details::txn_deleter<LmdbApi>{_api, this, std::move(resize_lock)}};
+    }
+
+    auto release(MDB_txn *const txn) noexcept -> void
+    {
+        _api.mdb_txn_reset(txn);
+
+        {
+            std::lock_guard const lock{_mutex};
+            if (_idle.size() < _capacity) {
+                _idle.push_back(txn);
+                return;
+            }
+        }
+
+        _api.mdb_txn_abort(txn);
+    }
+
+    auto stats() const noexcept -> ro_txn_pool_stats_t
+    {
+        return {
+            _hits.load(std::memory_order_relaxed),
+            _misses.load(std::memory_order_relaxed)};
+    }
+
+    auto api() const noexcept -> LmdbApi const &
+    {
+        return _api;
+    }
+
+    // read-only cursors shared by transactions acquired from the pool
+    auto cursors() noexcept -> details::cursor_cache<LmdbApi> &
+    {
+        return _cursors;
+    }
+
+private:
+    auto pop_idle() -> MDB_txn *
+    {
+        std::lock_guard const lock{_mutex};
+        if (_idle.empty())
+            return nullptr;
+
+        auto *txn = _idle.back();
+        _idle.pop_back();
+        return txn;
+    }
+
+    LmdbApi const &_api;
+    MDB_env &_env;
+    size_t const _capacity;
+    details::map_resize_guard *const _resize_guard;
+
+    std::mutex _mutex;
+    std::vector<MDB_txn *> _idle;
+
+    std::atomic<size_t> _hits;
+    std::atomic<size_t> _misses;
+
+    details::cursor_cache<LmdbApi> _cursors{_api, read_only_t::yes};
+};
+
+}  // namespace lmdb
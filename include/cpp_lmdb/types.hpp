@@ -2,6 +2,13 @@
 
 #include <span>
 
+// Lets clang diagnose views that outlive the object they were obtained from.
+#if defined(__has_cpp_attribute) && __has_cpp_attribute(clang::lifetimebound)
+#define CPP_LMDB_LIFETIMEBOUND [[clang::lifetimebound]]
+#else
+#define CPP_LMDB_LIFETIMEBOUND
+#endif
+
 namespace lmdb
 {
 
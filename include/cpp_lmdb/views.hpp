@@ -2,6 +2,7 @@
 
 #include "cpp_lmdb/iterators.hpp"
 
+#include <memory>
 #include <ranges>
 
 namespace lmdb
@@ -61,4 +62,35 @@ private:
     std::vector<std::byte> _key;
 };
 
+template <std::input_iterator Iterator, lmdb_api_like LmdbApi>
+class db_range_view
+    : public std::ranges::view_interface<db_range_view<Iterator, LmdbApi>> {
+public:
+    db_range_view(
+        details::cursor_unique_ptr_t<LmdbApi> &&cursor,
+        details::cursor_range &&range)
+        : _cursor{std::move(cursor)}
+        , _range{std::make_unique<details::cursor_range>(std::move(range))}
+    {}
+
+    db_range_view(db_range_view &&) noexcept = default;
+    auto operator=(db_range_view &&) noexcept -> db_range_view & = default;
+
+    auto begin() const
+    {
+        auto const &api = _cursor.get_deleter().api;
+        return Iterator{api.get(), *_cursor, *_range};
+    }
+
+    auto end() const noexcept
+    {
+        return std::default_sentinel;
+    }
+
+private:
+    details::cursor_unique_ptr_t<LmdbApi> _cursor;
+    // iterators refer to the range, which must not move with the view
+    std::unique_ptr<details::cursor_range> _range;
+};
+
 }  // namespace lmdb
@@ -0,0 +1,234 @@
+#pragma once
+
+#include "cpp_lmdb/concepts.hpp"
+#include "cpp_lmdb/dbs.hpp"
+#include "cpp_lmdb/error.hpp"
+
+// details
+#include "cpp_lmdb/details/key_value_traits.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <expected>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+namespace lmdb
+{
+
+struct write_coordinator_options_t {
+    // at least one operation per batch, zero is treated as one
+    size_t max_batch_size{64};
+    // time the writer waits for more operations after the first one arrived
+    std::chrono::microseconds max_batch_delay{};
+    // every operation runs in a nested transaction, so a failed operation
+    // is discarded without failing the rest of the batch; must be disabled
+    // for environments opened with write_map
+    bool isolate_operations{true};
+};
+
+struct write_coordinator_stats_t {
+    size_t batches{};
+    size_t operations{};
+    size_t max_batch_size{};
+    std::chrono::nanoseconds total_queue_wait{};
+    std::chrono::nanoseconds max_queue_wait{};
+};
+
+// Group commit: operations submitted from any thread are applied by a single
+// writer thread, which coalesces everything queued into one write
+// transaction with one commit and then completes the submitters' futures.
+template <key_value_trait KeyValueTrait, lmdb_api_like LmdbApi>
+class write_coordinator {
+public:
+    using rw_db_type = rw_db<KeyValueTrait, LmdbApi>;
+    using rw_transaction = typename rw_db_type::rw_transaction;
+    using result_type = std::expected<void, error_t>;
+    using operation = std::function<result_type(rw_transaction &)>;
+
+    explicit write_coordinator(
+        rw_db_type &db, write_coordinator_options_t const &options = {})
+        : _db{db}
+        , _options{[&options] {
+            auto clamped = options;
+            clamped.max_batch_size
+                = std::max(options.max_batch_size, size_t{1});
+            return clamped;
+        }()}
+        , _writer{[this](std::stop_token const &stop) { run(stop); }}
+    {}
+
+    write_coordinator(write_coordinator const &) = delete;
+    auto operator=(write_coordinator const &) -> write_coordinator & = delete;
+
+    // queued operations are still committed when the coordinator is
+    // destroyed
+    ~write_coordinator() = default;
+
+    auto submit(operation op) -> std::future<result_type>
+    {
+        std::promise<result_type> promise;
+        auto future = promise.get_future();
+
+        {
+            std::lock_guard const lock{_mutex};
+            _queue.push_back(
+                request{std::move(op), std::move(promise), clock::now(), {}});
+        }
+        _queue_changed.notify_one();
+
+        return future;
+    }
+
+    auto stats() const noexcept -> write_coordinator_stats_t
+    {
+        return {
+            _batches.load(std::memory_order_relaxed),
+            _operations.load(std::memory_order_relaxed),
+            _max_batch_size.load(std::memory_order_relaxed),
+            std::chrono::nanoseconds{
+                _total_queue_wait.load(std::memory_order_relaxed)},
+            std::chrono::nanoseconds{
+                _max_queue_wait.load(std::memory_order_relaxed)}};
+    }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct request {
+        operation op;
+        std::promise<result_type> promise;
+        clock::time_point enqueued;
+        result_type result;
+    };
+
+    auto run(std::stop_token const &stop) -> void
+    {
+        std::vector<request> batch;
+        batch.reserve(_options.max_batch_size);
+
+        while (true) {
+            {
+                std::unique_lock lock{_mutex};
+                if (!_queue_changed.wait(
+                        lock, stop, [this] { return !_queue.empty(); }))
+                    return;
+
+                if (_options.max_batch_delay.count() != 0
+                    && _queue.size() < _options.max_batch_size) {
+                    _queue_changed.wait_for(
+                        lock, stop, _options.max_batch_delay, [this] {
+                            return _queue.size() >= _options.max_batch_size;
+                        });
+                }
+
+                auto const count
+                    = std::min(_queue.size(), _options.max_batch_size);
+                for (size_t i = 0; i < count; ++i) {
+                    batch.push_back(std::move(_queue.front()));
+                    _queue.pop_front();
+                }
+            }
+
+            process(batch);
+            batch.clear();
+        }
+    }
+
+    auto process(std::vector<request> &batch) -> void
+    {
+        record_stats(batch);
+
+        try {
+            auto const committed
+                = _db.write([this, &batch](rw_transaction &txn) {
+                      return apply(txn, batch);
+                  });
+
+            for (auto &request : batch) {
+                request.promise.set_value(
+                    committed ? request.result
+                              : std::unexpected{committed.error()});
+            }
+        } catch (...) {
+            for (auto &request : batch)
+                request.promise.set_exception(std::current_exception());
+        }
+    }
+
+    auto apply(rw_transaction &txn, std::vector<request> &batch)
+        -> result_type
+    {
+        for (auto &request : batch) {
+            if (!_options.isolate_operations) {
+                if (request.result = request.op(txn); !request.result)
+                    return request.result;
+                continue;
+            }
+
+            auto nested = txn.begin_nested();
+            if (!nested)
+                return std::unexpected{nested.error()};
+
+            request.result = request.op(*nested);
+            if (!request.result && request.result.error() == error_t::map_full)
+                return request.result;
+
+            if (request.result) {
+                if (auto const merged = txn.merge_nested(std::move(*nested));
+                    !merged)
+                    return merged;
+            }
+        }
+
+        return {};
+    }
+
+    auto record_stats(std::vector<request> const &batch) noexcept -> void
+    {
+        auto const now = clock::now();
+        for (auto const &request : batch) {
+            auto const wait = std::chrono::duration_cast<
+                                  std::chrono::nanoseconds>(
+                                  now - request.enqueued)
+                                  .count();
+            _total_queue_wait.fetch_add(wait, std::memory_order_relaxed);
+            if (wait > _max_queue_wait.load(std::memory_order_relaxed))
+                _max_queue_wait.store(wait, std::memory_order_relaxed);
+        }
+
+        _batches.fetch_add(1, std::memory_order_relaxed);
+        _operations.fetch_add(batch.size(), std::memory_order_relaxed);
+        if (batch.size() > _max_batch_size.load(std::memory_order_relaxed))
+            _max_batch_size.store(batch.size(), std::memory_order_relaxed);
+    }
+
+private:
+    rw_db_type &_db;
+    write_coordinator_options_t const _options;
+
+    std::mutex _mutex;
+    std::condition_variable_any _queue_changed;
+    std::deque<request> _queue;
+
+    std::atomic<size_t> _batches{};
+    std::atomic<size_t> _operations{};
+    std::atomic<size_t> _max_batch_size{};
+    std::atomic<std::chrono::nanoseconds::rep> _total_queue_wait{};
+    std::atomic<std::chrono::nanoseconds::rep> _max_queue_wait{};
+
+    // declared last to stop the writer before other members are destroyed
+    std::jthread _writer;
+};
+
+}  // namespace lmdb
@@ -0,0 +1,141 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+// std
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Compares the key representations available for numeric keys: native
+// integers under MDB_INTEGERKEY (numeric_trait), order-preserving bytes
+// under the default memcmp (ordered_numeric_trait) and native bytes sorted
+// by a custom comparator called back through a function pointer.
+//
+// usage: numeric_keys_benchmark [item count]
+namespace
+{
+constexpr auto bench_env = "./bench_env_numeric_keys";
+
+template <typename T>
+struct custom_cmp_trait : lmdb::trivial_trait<T> {
+    static auto cmp(
+        std::span<std::byte const> const &lhs,
+        std::span<std::byte const> const &rhs) -> int
+    {
+        T lhs_value{};
+        T rhs_value{};
+        std::memcpy(&lhs_value, lhs.data(), sizeof(T));
+        std::memcpy(&rhs_value, rhs.data(), sizeof(T));
+        return lhs_value < rhs_value ? -1 : (rhs_value < lhs_value ? 1 : 0);
+    }
+};
+
+template <typename T>
+auto make_keys(size_t const count) -> std::vector<T>
+{
+    std::vector<T> keys(count);
+    std::mt19937_64 random{42};
+    for (auto &key : keys) {
+        if constexpr (std::is_floating_point_v<T>) {
+            key = std::uniform_real_distribution<T>{-1e9, 1e9}(random);
+        } else {
+            key = std::uniform_int_distribution<T>{
+                std::numeric_limits<T>::min(),
+                std::numeric_limits<T>::max()}(random);
+        }
+    }
+    return keys;
+}
+
+template <typename Fn>
+auto measure_ms(Fn &&fn) -> double
+{
+    auto const start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+template <typename KeyTrait>
+auto run(
+    char const *const name,
+    std::vector<typename KeyTrait::value_type> const &keys) -> void
+{
+    using trait = lmdb::unique_key<KeyTrait, lmdb::trivial_trait<uint64_t>>;
+
+    if (std::filesystem::exists(bench_env))
+        std::filesystem::remove_all(bench_env);
+    std::filesystem::create_directory(bench_env);
+
+    auto environment
+        = lmdb::make_environment<lmdb::env_flags_t::no_sync, 1>(
+              bench_env, lmdb::default_file_mode, {.map_size = 1UL << 30})
+              .value();
+    auto db = environment
+                  .open_rw_db<trait>("bench", lmdb::create_if_not_exists::yes)
+                  .value();
+
+    auto const insert_ms = measure_ms([&] {
+        auto txn = db.begin_rw_transaction().value();
+        for (size_t i = 0; i < keys.size(); ++i)
+            (void)txn.insert(keys[i], i);
+        (void)db.commit_transaction(std::move(txn));
+    });
+
+    uint64_t checksum{};
+    auto const get_ms = measure_ms([&] {
+        auto const txn = db.begin_ro_transaction().value();
+        for (auto const &key : keys)
+            checksum += txn.get(key).value_or(0);
+    });
+
+    auto const scan_ms = measure_ms([&] {
+        auto const txn = db.begin_ro_transaction().value();
+        auto const view = txn.iterate().value();
+        for (auto const &item : view)
+            checksum += item.value();
+    });
+
+    std::printf(
+        "%-32s %10.2f %10.2f %10.2f   (%llu)\n",
+        name,
+        insert_ms,
+        get_ms,
+        scan_ms,
+        static_cast<unsigned long long>(checksum));
+}
+
+template <typename T>
+auto run_all(char const *const type_name, size_t const count) -> void
+{
+    auto const keys = make_keys<T>(count);
+    std::printf("\n%s, %zu keys\n", type_name, count);
+    std::printf(
+        "%-32s %10s %10s %10s\n", "trait", "insert ms", "get ms", "scan ms");
+    run<lmdb::numeric_trait<T>>("numeric_trait", keys);
+    run<lmdb::ordered_numeric_trait<T>>("ordered_numeric_trait", keys);
+    run<custom_cmp_trait<T>>("trivial_trait with cmp", keys);
+}
+}  // namespace
+
+auto main(int const argc, char const *const *const argv) -> int
+{
+    size_t const count
+        = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    run_all<uint32_t>("uint32_t", count);
+    run_all<int64_t>("int64_t", count);
+    run_all<double>("double", count);
+    run_all<int16_t>("int16_t", count);
+
+    std::filesystem::remove_all(bench_env);
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <coroutine>
+#include <exception>
+#include <filesystem>
+#include <future>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using test_trait = lmdb::
+    unique_key<lmdb::trivial_trait<unsigned int>, lmdb::trivial_trait<int>>;
+
+// eagerly started coroutine, completion is observed through the future. The
+// frame outlives the lambda creating it, so state is passed as parameters.
+struct test_coroutine {
+    struct promise_type {
+        auto get_return_object() -> test_coroutine
+        {
+            return {done.get_future()};
+        }
+
+        auto initial_suspend() noexcept -> std::suspend_never
+        {
+            return {};
+        }
+
+        auto final_suspend() noexcept -> std::suspend_never
+        {
+            return {};
+        }
+
+        auto return_void() -> void
+        {
+            done.set_value();
+        }
+
+        auto unhandled_exception() -> void
+        {
+            done.set_exception(std::current_exception());
+        }
+
+        std::promise<void> done;
+    };
+
+    std::future<void> finished;
+};
+
+class async_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+    }
+
+    constexpr static auto test_env = "./test_env_async";
+};
+
+TEST_F(async_test, write_get_and_scan)
+{
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    lmdb::thread_pool_executor executor{2};
+
+    auto coroutine = [](auto &rw_db,
+                        auto &executor,
+                        unsigned int const item_count) -> test_coroutine {
+        auto const written = co_await lmdb::async_write(
+            rw_db,
+            [item_count](auto &txn) -> std::expected<void, lmdb::error_t> {
+                for (unsigned int key = 0; key < item_count; ++key) {
+                    if (auto const result
+                        = txn.insert(key, static_cast<int>(key) * 2);
+                        !result)
+                        return result;
+                }
+                return {};
+            },
+            executor);
+        EXPECT_TRUE(written);
+
+        auto const value = co_await lmdb::async_get(rw_db, 21u, executor);
+        EXPECT_EQ(value.value_or(-1), 42);
+
+        auto const missing
+            = co_await lmdb::async_get(rw_db, item_count, executor);
+        EXPECT_FALSE(missing);
+        EXPECT_EQ(missing.error(), lmdb::error_t::not_found);
+
+        std::vector<std::pair<unsigned int, int>> items;
+        {
+            auto scan = lmdb::async_iterate(rw_db, executor, 8);
+            while (auto const item = co_await scan.next())
+                items.emplace_back(item->key(), item->value());
+            EXPECT_FALSE(scan.error());
+        }
+
+        EXPECT_EQ(items.size(), item_count);
+        for (unsigned int key = 0; key < items.size(); ++key) {
+            EXPECT_EQ(items[key].first, key);
+            EXPECT_EQ(items[key].second, static_cast<int>(key) * 2);
+        }
+    }(*rw_db, executor, 100);
+
+    coroutine.finished.get();
+}
+
+TEST_F(async_test, scan_destroyed_before_end)
+{
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    ASSERT_TRUE(rw_db->write(
+        [](auto &txn) -> std::expected<void, lmdb::error_t> {
+            for (unsigned int key = 0; key < 1000; ++key) {
+                if (auto const result = txn.insert(key, 0); !result)
+                    return result;
+            }
+            return {};
+        }));
+
+    // the scan is destroyed before completion is signalled
+    auto coroutine = [](auto &rw_db) -> test_coroutine {
+        {
+            auto scan
+                = lmdb::async_iterate(rw_db, lmdb::default_executor(), 4);
+            auto const first = co_await scan.next();
+            EXPECT_TRUE(first);
+            EXPECT_EQ(first->key(), 0u);
+        }
+    }(*rw_db);
+
+    coroutine.finished.get();
+}
+
+}  // namespace cpp_lmdb_tests
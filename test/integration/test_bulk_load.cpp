@@ -0,0 +1,169 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+#include "test_utils.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <cstddef>
+#include <expected>
+#include <filesystem>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using unique_trait = lmdb::
+    unique_key<lmdb::trivial_trait<unsigned int>, lmdb::trivial_trait<int>>;
+using dup_trait = lmdb::
+    duplicate_key<lmdb::trivial_trait<unsigned int>, lmdb::trivial_trait<int>>;
+
+class bulk_load_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+    }
+
+    constexpr static auto test_env = "./test_env_bulk_load";
+};
+
+TEST_F(bulk_load_test, sorted_pairs_loaded_in_chunks)
+{
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<unique_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    auto const pairs
+        = std::views::iota(0u, 10u) | std::views::transform([](auto key) {
+              return std::pair{key, static_cast<int>(key) * 10};
+          });
+
+    auto const loaded = rw_db->bulk_load(pairs, {.chunk_size = 3});
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(*loaded, 10);
+
+    auto const more = rw_db->bulk_load(
+        std::vector<std::pair<unsigned int, int>>{{10, 100}, {11, 110}});
+    ASSERT_TRUE(more);
+    EXPECT_EQ(*more, 2);
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+    EXPECT_THAT(
+        get_all_values(ro_tx->iterate().value()),
+        ElementsAre(0, 10, 20, 30, 40, 50, 60, 70, 80, 90, 100, 110));
+}
+
+TEST_F(bulk_load_test, unordered_input_reported)
+{
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<unique_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    std::vector<std::pair<unsigned int, int>> const pairs{
+        {1, 1}, {2, 2}, {3, 3}, {5, 5}, {4, 4}, {6, 6}};
+
+    auto const loaded = rw_db->bulk_load(pairs, {.chunk_size = 2});
+    ASSERT_FALSE(loaded);
+    EXPECT_EQ(loaded.error().error, lmdb::error_t::key_exist);
+    EXPECT_EQ(loaded.error().position, 4);
+    EXPECT_EQ(loaded.error().committed, 4);
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+    EXPECT_THAT(
+        get_all_values(ro_tx->iterate().value()), ElementsAre(1, 2, 3, 5));
+}
+
+TEST_F(bulk_load_test, sorted_duplicates_loaded)
+{
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<dup_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    std::vector<std::pair<unsigned int, int>> const pairs{
+        {1, 1}, {1, 2}, {1, 3}, {2, 1}, {3, 5}, {3, 6}};
+
+    auto const loaded = rw_db->bulk_load(pairs, {.chunk_size = 4});
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(*loaded, pairs.size());
+
+    auto const unordered = rw_db->bulk_load(
+        std::vector<std::pair<unsigned int, int>>{{4, 7}, {4, 4}});
+    ASSERT_FALSE(unordered);
+    EXPECT_EQ(unordered.error().error, lmdb::error_t::key_exist);
+    EXPECT_EQ(unordered.error().position, 1);
+    EXPECT_EQ(unordered.error().committed, 0);
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+    EXPECT_THAT(
+        get_all_values(ro_tx->iterate().value()),
+        ElementsAre(1, 2, 3, 1, 5, 6));
+}
+
+TEST_F(bulk_load_test, failed_commit_reports_restart_point)
+{
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<unique_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    // fails the second commit
+    struct failing_listener
+        : lmdb::details::commit_listener<lmdb::details::api> {
+        auto before_commit(
+            lmdb::details::api const & /*api*/,
+            MDB_txn * /*txn*/,
+            lmdb::details::written_keys_t const * /*keys*/)
+            -> std::expected<void, lmdb::error_t> override
+        {
+            if (++commits == 2)
+                return std::unexpected{lmdb::error_t::map_full};
+            return {};
+        }
+
+        size_t commits{};
+    } listener;
+    rw_db->add_commit_listener(&listener);
+
+    std::vector<std::pair<unsigned int, int>> const pairs{
+        {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
+
+    auto const loaded = rw_db->bulk_load(pairs, {.chunk_size = 2});
+    rw_db->remove_commit_listener(&listener);
+    ASSERT_FALSE(loaded);
+    EXPECT_EQ(loaded.error().error, lmdb::error_t::map_full);
+    EXPECT_FALSE(loaded.error().position);
+    EXPECT_EQ(loaded.error().committed, 2);
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+    EXPECT_THAT(get_all_values(ro_tx->iterate().value()), ElementsAre(1, 2));
+}
+
+}  // namespace cpp_lmdb_tests
@@ -0,0 +1,235 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+#include "test_utils.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+namespace
+{
+auto as_bytes(std::string const &value) -> std::vector<std::byte>
+{
+    auto const bytes = std::as_bytes(std::span{value.data(), value.size()});
+    return {bytes.begin(), bytes.end()};
+}
+
+auto make_record(size_t const id) -> std::string
+{
+    return R"({"id":)" + std::to_string(id)
+           + R"(,"status":"shipped","carrier":"postal","priority":)"
+           + std::to_string(id % 3) + R"(,"tags":["fragile","gift"]})";
+}
+
+auto round_trip(
+    std::vector<std::byte> const &input,
+    std::vector<std::byte> const &dictionary = {})
+    -> std::optional<std::vector<std::byte>>
+{
+    std::vector<std::byte> compressed;
+    lmdb::lz_codec::compress(input, dictionary, compressed);
+
+    std::vector<std::byte> output;
+    if (!lmdb::lz_codec::decompress(compressed, dictionary, output))
+        return std::nullopt;
+    return output;
+}
+
+struct orders_tag;
+using orders_dictionary = lmdb::trained_dictionary<orders_tag>;
+}  // namespace
+
+class compressed_values_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+
+        _environment.emplace(
+            lmdb::make_environment<lmdb::env_flags_t::none, 4>(
+                test_env, lmdb::default_file_mode)
+                .value());
+    }
+
+    constexpr static auto test_env = "./test_env_compressed_values";
+
+    std::optional<lmdb::rw_environment<>> _environment;
+};
+
+TEST(lz_codec_test, round_trips)
+{
+    std::mt19937 random{7};
+    std::vector<std::byte> noise(5000);
+    for (auto &byte : noise)
+        byte = static_cast<std::byte>(random());
+
+    std::vector<std::byte> runs;
+    for (size_t i = 0; i < 3000; ++i)
+        runs.push_back(static_cast<std::byte>(i / 700));
+
+    for (auto const &input :
+         {std::vector<std::byte>{},
+          as_bytes("abc"),
+          as_bytes("abcdabcdabcdabcdabcdabcdabcdabcdabcdabcd"),
+          as_bytes(make_record(1) + make_record(2)),
+          noise,
+          runs}) {
+        EXPECT_EQ(round_trip(input), input);
+    }
+
+    auto const dictionary = as_bytes(make_record(0));
+    auto const record = as_bytes(make_record(123));
+    EXPECT_EQ(round_trip(record, dictionary), record);
+
+    std::vector<std::byte> with_dictionary;
+    lmdb::lz_codec::compress(record, dictionary, with_dictionary);
+    std::vector<std::byte> without_dictionary;
+    lmdb::lz_codec::compress(record, {}, without_dictionary);
+    EXPECT_LT(with_dictionary.size() * 3, without_dictionary.size());
+
+    // offsets past the start of the output without a dictionary
+    std::vector<std::byte> output;
+    EXPECT_FALSE(lmdb::lz_codec::decompress(with_dictionary, {}, output));
+}
+
+TEST_F(compressed_values_test, values_are_compressed_transparently)
+{
+    using value_trait = lmdb::compressed<lmdb::string_trait>;
+    using trait = lmdb::unique_key<lmdb::trivial_trait<uint32_t>, value_trait>;
+
+    auto rw_db = _environment
+                     ->open_rw_db<trait>(
+                         "orders", lmdb::create_if_not_exists::yes)
+                     .value();
+
+    std::string large;
+    for (size_t i = 0; i < 20; ++i)
+        large += make_record(i);
+
+    value_trait::reset_stats();
+    {
+        auto txn = rw_db.begin_rw_transaction().value();
+        EXPECT_TRUE(txn.insert(1, large));
+        EXPECT_TRUE(txn.insert(2, "small"));
+        EXPECT_TRUE(txn.insert(3, ""));
+        EXPECT_TRUE(rw_db.commit_transaction(std::move(txn)));
+    }
+
+    auto const stats = value_trait::stats();
+    EXPECT_EQ(stats.values, 3);
+    EXPECT_EQ(stats.compressed_values, 1);
+    EXPECT_EQ(stats.input_bytes, large.size() + 5);
+    EXPECT_GT(stats.ratio(), 4.0);
+
+    auto const ro_tx = rw_db.begin_ro_transaction().value();
+    EXPECT_EQ(ro_tx.get(1).value(), large);
+    EXPECT_EQ(ro_tx.get(2).value(), "small");
+    EXPECT_EQ(ro_tx.get(3).value(), "");
+
+    // raw values are stored behind a one-byte header
+    EXPECT_EQ(ro_tx.get_view(2).value().size(), 6);
+    EXPECT_LT(ro_tx.get_view(1).value().size(), large.size() / 4);
+
+    std::vector<std::byte> const corrupted{std::byte{7}};
+    EXPECT_THROW(value_trait::from_bytes(corrupted), std::runtime_error);
+    EXPECT_EQ(
+        value_trait::try_from_bytes(corrupted).error(),
+        lmdb::error_t::corrupted);
+
+    // values failing to decode are reported by get
+    using raw_trait = lmdb::
+        unique_key<lmdb::trivial_trait<uint32_t>, lmdb::byte_vector_trait>;
+    auto raw_db = _environment->open_rw_db<raw_trait>("orders").value();
+    ASSERT_TRUE(raw_db.write([&corrupted](auto &txn) {
+        return txn.insert(4, corrupted);
+    }));
+    EXPECT_EQ(
+        rw_db.begin_ro_transaction().value().get(4).error(),
+        lmdb::error_t::corrupted);
+}
+
+TEST_F(compressed_values_test, trained_dictionary)
+{
+    using value_trait = lmdb::compressed<
+        lmdb::string_trait,
+        lmdb::lz_codec,
+        orders_dictionary,
+        32>;
+    using trait = lmdb::unique_key<lmdb::trivial_trait<uint32_t>, value_trait>;
+
+    auto dictionaries
+        = _environment
+              ->open_rw_db<lmdb::dictionary_db_trait>(
+                  "dictionaries", lmdb::create_if_not_exists::yes)
+              .value();
+    auto rw_db = _environment
+                     ->open_rw_db<trait>(
+                         "orders", lmdb::create_if_not_exists::yes)
+                     .value();
+
+    EXPECT_EQ(
+        lmdb::train_dictionary(dictionaries, "orders", rw_db).error(),
+        lmdb::error_t::not_found);
+
+    auto const insert = [&rw_db](uint32_t const first, uint32_t const last) {
+        auto txn = rw_db.begin_rw_transaction().value();
+        for (auto id = first; id < last; ++id)
+            EXPECT_TRUE(txn.insert(id, make_record(id)));
+        EXPECT_TRUE(rw_db.commit_transaction(std::move(txn)));
+    };
+
+    value_trait::reset_stats();
+    insert(0, 200);
+    auto const before = value_trait::stats();
+
+    ASSERT_TRUE(lmdb::train_dictionary(
+        dictionaries, "orders", rw_db, {.sample_count = 50}));
+    EXPECT_FALSE(orders_dictionary::bytes().empty());
+
+    value_trait::reset_stats();
+    insert(200, 400);
+    auto const after = value_trait::stats();
+    EXPECT_GT(after.ratio(), before.ratio() * 2);
+
+    auto const ro_tx = rw_db.begin_ro_transaction().value();
+    for (uint32_t id = 0; id < 400; ++id)
+        EXPECT_EQ(ro_tx.get(id).value(), make_record(id));
+
+    // the stored dictionary is loaded again instead of being retrained
+    auto const dictionary = [] {
+        auto const bytes = orders_dictionary::bytes();
+        return std::vector<std::byte>{bytes.begin(), bytes.end()};
+    };
+    auto const trained = dictionary();
+
+    // values compressed with another dictionary are rejected
+    auto replaced = trained;
+    replaced.back() ^= std::byte{1};
+    orders_dictionary::install(replaced);
+    EXPECT_EQ(ro_tx.get(399).error(), lmdb::error_t::incompatible);
+    EXPECT_EQ(ro_tx.get(0).value(), make_record(0));
+
+    orders_dictionary::install({});
+    ASSERT_TRUE(lmdb::train_dictionary(dictionaries, "orders", rw_db));
+    EXPECT_EQ(dictionary(), trained);
+}
+
+}  // namespace cpp_lmdb_tests
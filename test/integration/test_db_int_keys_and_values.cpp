@@ -9,6 +9,9 @@
 // std
 #include <cstring>
 #include <filesystem>
+#include <numeric>
+#include <span>
+#include <vector>
 
 using namespace ::testing;  // NOLINT(google-build-using-namespace)
 
@@ -91,4 +94,177 @@ TEST(integration_test, db_int_keys_and_values_unique_key)
     }
 }
 
+TEST(integration_test, db_int_keys_and_values_nested_transactions)
+{
+    constexpr auto test_env = "./test_env";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+
+    ASSERT_TRUE(environment);
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+
+    ASSERT_TRUE(rw_db);
+
+    auto transaction = rw_db->begin_rw_transaction();
+    ASSERT_TRUE(transaction);
+    EXPECT_TRUE(transaction->insert(1, 1000));
+
+    {
+        auto nested = transaction->begin_nested();
+        ASSERT_TRUE(nested);
+        EXPECT_TRUE(nested->insert(2, 2000));
+        EXPECT_TRUE(transaction->merge_nested(std::move(*nested)));
+    }
+    {
+        auto nested = transaction->begin_nested();
+        ASSERT_TRUE(nested);
+        EXPECT_TRUE(nested->insert(3, 3000));
+    }
+
+    ASSERT_TRUE(rw_db->commit_transaction(std::move(*transaction)));
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+    EXPECT_THAT(
+        cpp_lmdb_tests::get_all_values(ro_tx->iterate().value()),
+        ElementsAre(1000, 2000));
+}
+
+TEST(integration_test, db_int_keys_and_values_multi_db_transaction)
+{
+    constexpr auto test_env = "./test_env";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 2>(
+        test_env, lmdb::default_file_mode);
+
+    ASSERT_TRUE(environment);
+    auto primary_db = environment->open_rw_db<test_trait>(
+        "primary_db", lmdb::create_if_not_exists::yes);
+    auto index_db = environment->open_rw_db<test_trait>(
+        "index_db", lmdb::create_if_not_exists::yes);
+
+    ASSERT_TRUE(primary_db);
+    ASSERT_TRUE(index_db);
+
+    {
+        auto transaction
+            = environment->begin_rw_transaction(*primary_db, *index_db);
+        ASSERT_TRUE(transaction);
+        EXPECT_TRUE(transaction->db<0>().insert(1, 1000));
+        EXPECT_TRUE(transaction->db<1>().insert(100, 1));
+        ASSERT_TRUE(environment->commit_transaction(std::move(*transaction)));
+    }
+    {
+        auto transaction
+            = environment->begin_rw_transaction(*primary_db, *index_db);
+        ASSERT_TRUE(transaction);
+        EXPECT_TRUE(transaction->db<0>().insert(2, 2000));
+        EXPECT_TRUE(transaction->db<1>().insert(200, 2));
+    }
+
+    auto const ro_tx
+        = environment->begin_ro_transaction(*primary_db, *index_db);
+    ASSERT_TRUE(ro_tx);
+    EXPECT_THAT(
+        cpp_lmdb_tests::get_all_values(ro_tx->db<0>().iterate().value()),
+        ElementsAre(1000));
+    EXPECT_THAT(
+        cpp_lmdb_tests::get_all_values(ro_tx->db<1>().iterate().value()),
+        ElementsAre(1));
+}
+
+namespace
+{
+// length-prefixed list of values encoded straight into the reserved page
+struct vector_value_trait {
+    using value_type = std::vector<uint32_t>;
+
+    static auto to_bytes(value_type const &) -> lmdb::byte_span
+    {
+        return {};
+    }
+
+    static auto from_bytes(lmdb::byte_span const &bytes) -> value_type
+    {
+        uint32_t size{};
+        std::memcpy(&size, bytes.data(), sizeof(size));
+
+        value_type value(size);
+        std::memcpy(
+            value.data(),
+            bytes.data() + sizeof(size),
+            size * sizeof(uint32_t));
+        return value;
+    }
+
+    static auto serialized_size(value_type const &value) -> size_t
+    {
+        return sizeof(uint32_t) + value.size() * sizeof(uint32_t);
+    }
+
+    static auto serialize_into(
+        value_type const &value, std::span<std::byte> const &bytes) -> void
+    {
+        auto const size = static_cast<uint32_t>(value.size());
+        std::memcpy(bytes.data(), &size, sizeof(size));
+        std::memcpy(
+            bytes.data() + sizeof(size),
+            value.data(),
+            value.size() * sizeof(uint32_t));
+    }
+};
+}  // namespace
+
+TEST(integration_test, db_int_keys_and_reserved_values)
+{
+    using reserve_trait = lmdb::
+        unique_key<lmdb::trivial_trait<uint8_t>, vector_value_trait>;
+
+    constexpr auto test_env = "./test_env";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+
+    ASSERT_TRUE(environment);
+    auto rw_db = environment->open_rw_db<reserve_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+
+    ASSERT_TRUE(rw_db);
+
+    std::vector<uint32_t> large_value(10000);
+    std::iota(large_value.begin(), large_value.end(), 0);
+
+    {
+        auto transaction = rw_db->begin_rw_transaction();
+        ASSERT_TRUE(transaction);
+        EXPECT_TRUE(transaction->insert(1, {1, 2, 3}));
+        EXPECT_TRUE(transaction->insert(2, large_value));
+        EXPECT_TRUE(transaction->insert(3, {}));
+        auto const result = transaction->try_insert(1, {4});
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error(), lmdb::error_t::key_exist);
+        ASSERT_TRUE(rw_db->commit_transaction(std::move(*transaction)));
+    }
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+    EXPECT_THAT(ro_tx->get(1).value(), ElementsAre(1, 2, 3));
+    EXPECT_EQ(ro_tx->get(2).value(), large_value);
+    EXPECT_TRUE(ro_tx->get(3).value().empty());
+}
+
 }  // namespace cpp_lmdb_tests
@@ -9,6 +9,9 @@
 // std
 #include <cstring>
 #include <filesystem>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 using namespace ::testing;  // NOLINT(google-build-using-namespace)
 
@@ -91,4 +94,63 @@ TEST(integration_test, db_string_keys_and_values_unique_key)
     }
 }
 
+TEST(integration_test, db_string_borrowed_reads)
+{
+    constexpr auto test_env = "./test_env";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+
+    ASSERT_TRUE(environment);
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+
+    ASSERT_TRUE(rw_db);
+
+    ASSERT_TRUE(rw_db->write(
+        [](auto &transaction) -> std::expected<void, lmdb::error_t> {
+            if (auto const result = transaction.insert("A", "ABC"); !result)
+                return result;
+            return transaction.insert("B", std::string(4096, 'x'));
+        }));
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+
+    static_assert(std::same_as<
+                  decltype(ro_tx->get_view("A")),
+                  std::expected<std::string_view, lmdb::error_t>>);
+    {
+        auto const result = ro_tx->get_view("A");
+        ASSERT_TRUE(result);
+        EXPECT_EQ(*result, "ABC");
+    }
+    {
+        auto const result = ro_tx->get_view("B");
+        ASSERT_TRUE(result);
+        EXPECT_EQ(*result, std::string(4096, 'x'));
+    }
+    {
+        auto const result = ro_tx->get_view("C");
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error(), lmdb::error_t::not_found);
+    }
+
+    auto const view = ro_tx->iterate_views();
+    ASSERT_TRUE(view);
+
+    std::vector<std::pair<std::string_view, size_t>> items;
+    for (auto const &[key, value] : *view)
+        items.emplace_back(key, value.size());
+    EXPECT_THAT(
+        items,
+        ElementsAre(
+            std::pair{std::string_view{"A"}, size_t{3}},
+            std::pair{std::string_view{"B"}, size_t{4096}}));
+}
+
 }  // namespace cpp_lmdb_tests
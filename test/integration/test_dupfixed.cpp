@@ -0,0 +1,155 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+#include "test_utils.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <cstdint>
+#include <filesystem>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using posting_list_trait = lmdb::duplicate_key<
+    lmdb::trivial_trait<uint32_t>,
+    lmdb::fixed_size_trait<uint64_t>>;
+
+TEST(integration_test, dupfixed_multiple_writes_and_page_reads)
+{
+    constexpr auto test_env = "./test_env_dupfixed";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<posting_list_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    std::vector<uint64_t> postings(5000);
+    std::iota(postings.begin(), postings.end(), uint64_t{1});
+
+    {
+        auto transaction = rw_db->begin_rw_transaction();
+        ASSERT_TRUE(transaction);
+
+        auto const written = transaction->insert_multiple(7, postings);
+        ASSERT_TRUE(written);
+        EXPECT_EQ(*written, postings.size());
+
+        EXPECT_TRUE(transaction->insert(8, 42));
+        EXPECT_EQ(transaction->insert_multiple(9, {}).value_or(1), 0);
+        ASSERT_TRUE(rw_db->commit_transaction(std::move(*transaction)));
+    }
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+
+    {
+        auto const pages = ro_tx->iterate_pages_by_key(7);
+        ASSERT_TRUE(pages);
+
+        std::vector<uint64_t> values;
+        size_t page_count{};
+        for (auto const &page : *pages) {
+            values.insert(values.end(), page.begin(), page.end());
+            ++page_count;
+        }
+
+        EXPECT_EQ(values, postings);
+        EXPECT_GT(page_count, 1);
+    }
+    {
+        auto const pages = ro_tx->iterate_pages_by_key(8);
+        ASSERT_TRUE(pages);
+        auto it = pages->begin();
+        ASSERT_NE(it, pages->end());
+        EXPECT_THAT(
+            std::vector<uint64_t>((*it).begin(), (*it).end()),
+            ElementsAre(42));
+        ++it;
+        EXPECT_EQ(it, pages->end());
+        EXPECT_EQ(it.error(), lmdb::error_t::not_found);
+    }
+    {
+        auto const pages = ro_tx->iterate_pages_by_key(9);
+        ASSERT_TRUE(pages);
+        EXPECT_EQ(pages->begin(), pages->end());
+    }
+    {
+        auto const view = ro_tx->iterate_by_key(8);
+        ASSERT_TRUE(view);
+        std::vector<uint64_t> values;
+        for (auto const &item : *view)
+            values.push_back(item.value());
+        EXPECT_THAT(values, ElementsAre(42));
+    }
+}
+
+// big-endian order-preserving encoding, unlike the in-memory layout
+struct ordered_fixed_size_trait : lmdb::ordered_numeric_trait<int64_t> {
+    using fixed_size_flag = std::true_type;
+};
+
+TEST(integration_test, dupfixed_multiple_writes_encode_values)
+{
+    constexpr auto test_env = "./test_env_dupfixed_encoded";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<lmdb::duplicate_key<
+        lmdb::trivial_trait<uint32_t>,
+        ordered_fixed_size_trait>>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    std::vector<int64_t> values(2000);
+    std::iota(values.begin(), values.end(), int64_t{-1000});
+
+    {
+        auto transaction = rw_db->begin_rw_transaction();
+        ASSERT_TRUE(transaction);
+
+        EXPECT_EQ(transaction->insert_multiple(1, values).value_or(0), 2000);
+        for (auto const value : values)
+            EXPECT_TRUE(transaction->insert(2, value));
+        ASSERT_TRUE(rw_db->commit_transaction(std::move(*transaction)));
+    }
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+
+    for (uint32_t const key : {1U, 2U}) {
+        auto const pages = ro_tx->iterate_pages_by_key(key);
+        ASSERT_TRUE(pages);
+
+        std::vector<int64_t> read;
+        for (auto const &page : *pages)
+            read.insert(read.end(), page.begin(), page.end());
+        EXPECT_EQ(read, values);
+
+        auto const view = ro_tx->iterate_by_key(key);
+        ASSERT_TRUE(view);
+        EXPECT_EQ(get_all_values(*view), values);
+    }
+}
+
+}  // namespace cpp_lmdb_tests
@@ -0,0 +1,73 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <array>
+#include <expected>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+TEST(integration_test, get_many_returns_results_in_caller_order)
+{
+    using test_trait
+        = lmdb::unique_key<lmdb::string_trait, lmdb::trivial_trait<int>>;
+
+    constexpr auto test_env = "./test_env_get_many";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    ASSERT_TRUE(rw_db->write(
+        [](auto &txn) -> std::expected<void, lmdb::error_t> {
+            for (int i = 0; i < 1000; ++i) {
+                if (auto const result
+                    = txn.insert("key" + std::to_string(i), i);
+                    !result)
+                    return result;
+            }
+            return {};
+        }));
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+
+    std::vector<std::string> const keys{
+        "key500", "key1", "missing", "key999", "key1", "key0"};
+    std::array<std::expected<int, lmdb::error_t>, 6> results;
+
+    ASSERT_TRUE(ro_tx->get_many(keys, results));
+    EXPECT_EQ(results[0].value_or(-1), 500);
+    EXPECT_EQ(results[1].value_or(-1), 1);
+    ASSERT_FALSE(results[2]);
+    EXPECT_EQ(results[2].error(), lmdb::error_t::not_found);
+    EXPECT_EQ(results[3].value_or(-1), 999);
+    EXPECT_EQ(results[4].value_or(-1), 1);
+    EXPECT_EQ(results[5].value_or(-1), 0);
+
+    std::array<std::expected<int, lmdb::error_t>, 2> too_small;
+    auto const result = ro_tx->get_many(keys, too_small);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), lmdb::error_t::invalid_argument);
+
+    EXPECT_TRUE(ro_tx->get_many(std::vector<std::string>{}, too_small));
+}
+
+}  // namespace cpp_lmdb_tests
@@ -0,0 +1,138 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+#include "test_utils.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+namespace
+{
+struct order {
+    uint32_t customer;
+    uint32_t total;
+
+    auto operator==(order const &) const -> bool = default;
+};
+
+using order_trait = lmdb::
+    unique_key<lmdb::trivial_trait<uint32_t>, lmdb::trivial_trait<order>>;
+using by_customer
+    = lmdb::secondary_index<lmdb::trivial_trait<uint32_t>, &order::customer>;
+using by_total = lmdb::secondary_index<
+    lmdb::numeric_trait<uint32_t>,
+    [](order const &value) { return value.total; }>;
+
+using record = std::pair<uint32_t, order>;
+
+template <typename View>
+auto count_items(View const &view) -> size_t
+{
+    return static_cast<size_t>(
+        std::ranges::distance(std::ranges::ref_view{view}));
+}
+}  // namespace
+
+class indexed_table_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+
+        _environment.emplace(
+            lmdb::make_environment<lmdb::env_flags_t::none, 3>(
+                test_env, lmdb::default_file_mode)
+                .value());
+    }
+
+    auto open_table()
+    {
+        return lmdb::open_indexed_table<order_trait, by_customer, by_total>(
+                   *_environment, "orders", lmdb::create_if_not_exists::yes)
+            .value();
+    }
+
+    constexpr static auto test_env = "./test_env_indexed_table";
+
+    std::optional<lmdb::rw_environment<>> _environment;
+};
+
+TEST_F(indexed_table_test, lookups_through_indices)
+{
+    auto table = open_table();
+    {
+        auto txn = table.begin_rw_transaction().value();
+        EXPECT_TRUE(txn.insert(5, {7, 300}));
+        EXPECT_TRUE(txn.insert(1, {7, 100}));
+        EXPECT_TRUE(txn.insert(3, {8, 250}));
+        EXPECT_TRUE(txn.insert(4, {7, 1000}));
+        EXPECT_TRUE(txn.insert(2, {9, 100}));
+        EXPECT_TRUE(table.commit_transaction(std::move(txn)));
+    }
+
+    auto const txn = table.begin_ro_transaction().value();
+    EXPECT_EQ(txn.get(3).value(), (order{8, 250}));
+
+    EXPECT_THAT(
+        txn.find<0>(7).value(),
+        ElementsAre(
+            record{1, {7, 100}}, record{4, {7, 1000}}, record{5, {7, 300}}));
+    EXPECT_THAT(txn.find<0>(1).value(), IsEmpty());
+
+    EXPECT_THAT(
+        txn.find_range<1>(100, 300).value(),
+        ElementsAre(
+            record{1, {7, 100}}, record{2, {9, 100}}, record{3, {8, 250}}));
+}
+
+TEST_F(indexed_table_test, writes_keep_indices_up_to_date)
+{
+    auto table = open_table();
+    {
+        auto txn = table.begin_rw_transaction().value();
+        EXPECT_TRUE(txn.insert(1, {7, 100}));
+        EXPECT_TRUE(txn.insert(2, {7, 200}));
+        EXPECT_TRUE(txn.insert(3, {8, 300}));
+
+        // moves the record to another customer, keeps its total
+        EXPECT_TRUE(txn.insert(2, {8, 200}));
+        EXPECT_TRUE(txn.delete_key(1));
+        EXPECT_EQ(txn.delete_key(1).error(), lmdb::error_t::not_found);
+        EXPECT_TRUE(table.commit_transaction(std::move(txn)));
+    }
+    {
+        // not committed
+        auto txn = table.begin_rw_transaction().value();
+        EXPECT_TRUE(txn.insert(4, {7, 400}));
+        EXPECT_TRUE(txn.delete_key(3));
+    }
+
+    auto const txn = table.begin_ro_transaction().value();
+    EXPECT_THAT(txn.find<0>(7).value(), IsEmpty());
+    EXPECT_THAT(
+        txn.find<0>(8).value(),
+        ElementsAre(record{2, {8, 200}}, record{3, {8, 300}}));
+    EXPECT_THAT(
+        txn.find_range<1>(0, 1000).value(),
+        ElementsAre(record{2, {8, 200}}, record{3, {8, 300}}));
+
+    EXPECT_EQ(count_items(txn.index<0>().iterate().value()), 2);
+    EXPECT_EQ(count_items(txn.index<1>().iterate().value()), 2);
+}
+
+}  // namespace cpp_lmdb_tests
@@ -0,0 +1,62 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using test_trait
+    = lmdb::unique_key<lmdb::trivial_trait<uint32_t>, lmdb::string_trait>;
+
+TEST(integration_test, instrumented_api_records_db_calls)
+{
+    constexpr auto test_env = "./test_env_instrumented_api";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    lmdb::instrumented_api<> api;
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode, api);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    auto const before = api.snapshot();
+    {
+        auto txn = rw_db->begin_rw_transaction().value();
+        for (uint32_t key = 0; key < 100; ++key)
+            ASSERT_TRUE(txn.insert(key, std::to_string(key)));
+        ASSERT_TRUE(rw_db->commit_transaction(std::move(txn)));
+    }
+    {
+        auto const txn = rw_db->begin_ro_transaction().value();
+        EXPECT_EQ(txn.get(1).value(), "1");
+        EXPECT_EQ(txn.get(100).error(), lmdb::error_t::not_found);
+    }
+
+    using lmdb::api_operation;
+    auto const stats = api.snapshot().since(before);
+    EXPECT_EQ(stats[api_operation::rw_txn_begin].calls(), 1);
+    EXPECT_EQ(stats[api_operation::ro_txn_begin].calls(), 1);
+    EXPECT_EQ(stats[api_operation::put].calls(), 100);
+    EXPECT_EQ(stats[api_operation::txn_commit].calls(), 1);
+    EXPECT_EQ(stats[api_operation::get].calls(), 2);
+    EXPECT_EQ(
+        stats[api_operation::get].errors(lmdb::error_t::not_found), 1);
+    EXPECT_GT(stats[api_operation::put].latency.percentile(99), 0);
+}
+
+}  // namespace cpp_lmdb_tests
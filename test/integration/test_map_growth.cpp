@@ -0,0 +1,62 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <filesystem>
+#include <string>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using test_trait = lmdb::unique_key<lmdb::string_trait, lmdb::string_trait>;
+
+TEST(integration_test, map_grows_on_map_full)
+{
+    constexpr auto test_env = "./test_env_map_growth";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    constexpr size_t initial_map_size{64 * 1024};
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env,
+        lmdb::default_file_mode,
+        lmdb::env_options_t{.map_size = initial_map_size});
+    ASSERT_TRUE(environment);
+
+    environment->set_map_growth_policy(
+        lmdb::map_growth_policy_t{.max_retries = 16});
+
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    constexpr size_t record_count{2000};
+    std::string const value(256, 'x');
+
+    auto const result = rw_db->write([&value](auto &transaction) {
+        for (size_t i = 0; i < record_count; ++i) {
+            if (auto const inserted
+                = transaction.insert(std::to_string(i), value);
+                !inserted)
+                return inserted;
+        }
+        return std::expected<void, lmdb::error_t>{};
+    });
+    ASSERT_TRUE(result);
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+    auto const stored = ro_tx->get(std::to_string(record_count - 1));
+    ASSERT_TRUE(stored);
+    EXPECT_EQ(*stored, value);
+}
+
+}  // namespace cpp_lmdb_tests
@@ -0,0 +1,169 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+#include "test_utils.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using filtered_trait
+    = lmdb::unique_key<lmdb::trivial_trait<uint32_t>, lmdb::string_trait>;
+using membership_filter
+    = lmdb::membership_filter<filtered_trait, lmdb::details::api>;
+
+class membership_filter_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+
+        _environment.emplace(
+            lmdb::make_environment<lmdb::env_flags_t::none, 2>(
+                test_env, lmdb::default_file_mode)
+                .value());
+        _db.emplace(_environment
+                        ->open_rw_db<filtered_trait>(
+                            "users", lmdb::create_if_not_exists::yes)
+                        .value());
+        _filter_db.emplace(
+            _environment
+                ->open_rw_db<lmdb::membership_filter_db_trait>(
+                    "users#filter", lmdb::create_if_not_exists::yes)
+                .value());
+    }
+
+    auto open_filter() -> std::unique_ptr<membership_filter>
+    {
+        return membership_filter::open(
+                   *_db, *_filter_db, {.expected_keys = 4096})
+            .value();
+    }
+
+    auto put(uint32_t const first, uint32_t const last, uint32_t step = 1)
+        -> void
+    {
+        auto txn = _db->begin_rw_transaction().value();
+        for (auto key = first; key < last; key += step)
+            EXPECT_TRUE(txn.insert(key, std::to_string(key)));
+        EXPECT_TRUE(_db->commit_transaction(std::move(txn)));
+    }
+
+    // keys found through the filter, which must be the keys of the db
+    auto found(membership_filter const &filter, uint32_t const last)
+        -> std::vector<uint32_t>
+    {
+        auto const txn = _db->begin_ro_transaction().value();
+        std::vector<uint32_t> keys;
+        for (uint32_t key = 0; key < last; ++key) {
+            auto const value = filter.get(txn, key);
+            EXPECT_EQ(value.has_value(), txn.get(key).has_value()) << key;
+            if (value)
+                keys.push_back(key);
+        }
+        return keys;
+    }
+
+    constexpr static auto test_env = "./test_env_membership_filter";
+
+    std::optional<lmdb::rw_environment<>> _environment;
+    std::optional<lmdb::rw_environment<>::rw_db<filtered_trait>> _db;
+    std::optional<
+        lmdb::rw_environment<>::rw_db<lmdb::membership_filter_db_trait>>
+        _filter_db;
+};
+
+TEST_F(membership_filter_test, definite_misses_skip_the_db)
+{
+    put(0, 2000, 2);
+    auto const filter = open_filter();
+    EXPECT_FALSE(filter->stale());
+
+    // written after the filter was built
+    put(1, 200, 2);
+
+    auto const keys = found(*filter, 4000);
+    EXPECT_EQ(keys.size(), 1100);
+
+    auto const stats = filter->stats();
+    EXPECT_EQ(stats.lookups, 4000);
+    EXPECT_EQ(
+        stats.definite_misses + stats.false_positives + keys.size(),
+        stats.lookups);
+    EXPECT_LT(stats.false_positives, 2900 / 20);
+
+    auto const txn = _db->begin_ro_transaction().value();
+    std::vector<uint32_t> const lookups{3001, 10, 7, 3, 999, 1500};
+    std::vector<std::expected<std::string, lmdb::error_t>> results(
+        lookups.size());
+    ASSERT_TRUE(filter->get_many(txn, lookups, results));
+    EXPECT_EQ(results[0].error(), lmdb::error_t::not_found);
+    EXPECT_EQ(results[1].value(), "10");
+    EXPECT_EQ(results[2].value(), "7");
+    EXPECT_EQ(results[3].value(), "3");
+    EXPECT_EQ(results[4].error(), lmdb::error_t::not_found);
+    EXPECT_EQ(results[5].value(), "1500");
+}
+
+TEST_F(membership_filter_test, rebuild_drops_deleted_keys_and_persists)
+{
+    put(0, 1000);
+    {
+        auto const filter = open_filter();
+
+        auto txn = _db->begin_rw_transaction().value();
+        for (uint32_t key = 500; key < 1000; ++key)
+            EXPECT_TRUE(txn.delete_key(key));
+        EXPECT_TRUE(_db->commit_transaction(std::move(txn)));
+
+        // deleted keys keep their bits until the rebuild
+        EXPECT_EQ(found(*filter, 1000).size(), 500);
+        EXPECT_EQ(filter->stats().false_positives, 500);
+
+        ASSERT_TRUE(filter->rebuild());
+        EXPECT_EQ(found(*filter, 1000).size(), 500);
+        EXPECT_LT(filter->stats().false_positives, 500 + 25);
+    }
+
+    // reopened from the side db, and kept up to date by later commits
+    auto const filter = open_filter();
+    EXPECT_FALSE(filter->stale());
+    put(2000, 2100);
+    EXPECT_EQ(found(*filter, 3000).size(), 600);
+    EXPECT_LT(filter->stats().false_positives, 50);
+}
+
+TEST_F(membership_filter_test, rebuild_runs_alongside_writers)
+{
+    put(0, 100);
+    auto const filter = open_filter();
+
+    std::thread writer{[this] {
+        for (uint32_t batch = 1; batch <= 50; ++batch)
+            put(batch * 100, batch * 100 + 100);
+    }};
+    for (size_t i = 0; i < 5; ++i)
+        EXPECT_TRUE(filter->rebuild());
+    writer.join();
+
+    EXPECT_EQ(found(*filter, 5100).size(), 5100);
+    EXPECT_FALSE(filter->stale());
+}
+
+}  // namespace cpp_lmdb_tests
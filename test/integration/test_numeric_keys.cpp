@@ -0,0 +1,185 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+#include "test_utils.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+namespace
+{
+template <typename View>
+auto get_all_keys(View const &view)
+{
+    return to_vector(
+        std::ranges::ref_view{view}
+        | std::views::transform([](auto const &item) { return item.key(); }));
+}
+
+template <typename T>
+auto test_values() -> std::vector<T>
+{
+    using limits = std::numeric_limits<T>;
+    std::vector<T> values{
+        limits::max(), T{0}, limits::lowest(), T{1}, T{42}, limits::min()};
+    // native and big-endian orders of these differ
+    if constexpr (std::is_integral_v<T>) {
+        for (auto const value : {0x100LL, 0x1234LL, 0x01000000LL}) {
+            if (std::cmp_less_equal(value, limits::max()))
+                values.push_back(static_cast<T>(value));
+        }
+    }
+    if constexpr (std::is_signed_v<T>)
+        values.insert(values.end(), {T{-1}, T{-42}});
+    if constexpr (std::is_floating_point_v<T>) {
+        values.insert(
+            values.end(),
+            {limits::infinity(), -limits::infinity(), T{-0.5}, T{0.25}});
+    }
+    return values;
+}
+}  // namespace
+
+class numeric_keys_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+
+        _environment.emplace(
+            lmdb::make_environment<lmdb::env_flags_t::none, 32>(
+                test_env, lmdb::default_file_mode)
+                .value());
+    }
+
+    // stores the test values of T in a db keyed by KeyTrait and checks that
+    // they are iterated in numeric order and read back unchanged
+    template <template <typename> typename KeyTrait, typename T>
+    auto check_order() -> void
+    {
+        using trait = lmdb::unique_key<KeyTrait<T>, lmdb::trivial_trait<T>>;
+
+        auto rw_db = _environment
+                         ->open_rw_db<trait>(
+                             std::to_string(_next_db++).c_str(),
+                             lmdb::create_if_not_exists::yes)
+                         .value();
+
+        auto values = test_values<T>();
+        {
+            auto txn = rw_db.begin_rw_transaction().value();
+            for (auto const value : values)
+                EXPECT_TRUE(txn.insert(value, value));
+            EXPECT_TRUE(rw_db.commit_transaction(std::move(txn)));
+        }
+
+        std::ranges::sort(values);
+        auto const last = std::ranges::unique(values).begin();
+        values.erase(last, values.end());
+
+        auto ro_tx = rw_db.begin_ro_transaction().value();
+        EXPECT_EQ(get_all_keys(ro_tx.iterate().value()), values);
+        for (auto const value : values)
+            EXPECT_EQ(ro_tx.get(value).value(), value);
+
+        // bounds are found by the db comparator
+        auto const lower = std::ranges::find(values, T{1});
+        auto const upper
+            = std::ranges::find(values, std::numeric_limits<T>::max());
+        EXPECT_EQ(
+            get_all_keys(ro_tx.iterate_range(*lower, *upper).value()),
+            std::vector<T>(lower, upper));
+    }
+
+    template <template <typename> typename KeyTrait>
+    auto check_all_types() -> void
+    {
+        check_order<KeyTrait, int8_t>();
+        check_order<KeyTrait, uint8_t>();
+        check_order<KeyTrait, int16_t>();
+        check_order<KeyTrait, uint16_t>();
+        check_order<KeyTrait, int32_t>();
+        check_order<KeyTrait, uint32_t>();
+        check_order<KeyTrait, int64_t>();
+        check_order<KeyTrait, uint64_t>();
+        check_order<KeyTrait, float>();
+        check_order<KeyTrait, double>();
+    }
+
+    constexpr static auto test_env = "./test_env_numeric_keys";
+
+    std::optional<lmdb::rw_environment<>> _environment;
+    int _next_db{};
+};
+
+TEST_F(numeric_keys_test, numeric_trait_sorts_numerically)
+{
+    check_all_types<lmdb::numeric_trait>();
+}
+
+TEST_F(numeric_keys_test, ordered_numeric_trait_sorts_numerically)
+{
+    check_all_types<lmdb::ordered_numeric_trait>();
+}
+
+TEST_F(numeric_keys_test, integer_duplicates_and_sampled_partitions)
+{
+    using trait = lmdb::duplicate_key<
+        lmdb::numeric_trait<int64_t>,
+        lmdb::numeric_trait<int32_t>>;
+
+    auto rw_db = _environment
+                     ->open_rw_db<trait>(
+                         "dups", lmdb::create_if_not_exists::yes)
+                     .value();
+    {
+        auto txn = rw_db.begin_rw_transaction().value();
+        for (int64_t key = -500; key < 500; ++key) {
+            EXPECT_TRUE(txn.insert(key, 7));
+            EXPECT_TRUE(txn.insert(key, -7));
+        }
+        EXPECT_TRUE(rw_db.commit_transaction(std::move(txn)));
+    }
+
+    {
+        auto ro_tx = rw_db.begin_ro_transaction().value();
+        EXPECT_THAT(
+            get_all_values(ro_tx.iterate_by_key(-3).value()),
+            ElementsAre(-7, 7));
+    }
+
+    auto const split_points = lmdb::details::sample_split_points(rw_db, 4);
+    ASSERT_TRUE(split_points);
+    EXPECT_THAT(*split_points, ElementsAre(-251, -1, 249));
+
+    auto const count = lmdb::parallel_scan(
+        rw_db,
+        4,
+        size_t{},
+        [](auto &view) {
+            return static_cast<size_t>(std::ranges::distance(view));
+        },
+        [](size_t const lhs, size_t const rhs) { return lhs + rhs; });
+    ASSERT_TRUE(count);
+    EXPECT_EQ(*count, 2000);
+}
+
+}  // namespace cpp_lmdb_tests
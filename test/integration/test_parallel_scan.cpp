@@ -0,0 +1,188 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using int_trait = lmdb::
+    unique_key<lmdb::trivial_trait<unsigned int>, lmdb::trivial_trait<int>>;
+using string_trait
+    = lmdb::unique_key<lmdb::string_trait, lmdb::trivial_trait<int>>;
+
+namespace
+{
+// collects the keys of a partition, concatenating the partials has to give
+// the keys of a serial scan
+auto const collect_keys = [](auto &view) {
+    std::vector<std::decay_t<decltype((*view.begin()).key())>> keys;
+    for (auto const &item : view)
+        keys.push_back(item.key());
+    return keys;
+};
+
+auto const concatenate = [](auto lhs, auto rhs) {
+    lhs.insert(lhs.end(), rhs.begin(), rhs.end());
+    return lhs;
+};
+}  // namespace
+
+class parallel_scan_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+    }
+
+    template <typename Trait, typename Pairs>
+    auto open_db(Pairs const &pairs)
+    {
+        _environment.emplace(
+            lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+                test_env, lmdb::default_file_mode)
+                .value());
+
+        auto rw_db = _environment
+                         ->open_rw_db<Trait>(
+                             "test_db", lmdb::create_if_not_exists::yes)
+                         .value();
+        EXPECT_TRUE(rw_db.bulk_load(pairs));
+        return rw_db;
+    }
+
+    static auto int_pairs(unsigned int const count)
+    {
+        std::vector<std::pair<unsigned int, int>> pairs;
+        for (unsigned int i = 0; i < count; ++i)
+            pairs.emplace_back(i * 3, static_cast<int>(i));
+        return pairs;
+    }
+
+    constexpr static auto test_env = "./test_env_parallel_scan";
+
+private:
+    std::optional<lmdb::rw_environment<>> _environment;
+};
+
+TEST_F(parallel_scan_test, user_boundaries)
+{
+    auto const pairs = int_pairs(1000);
+    auto rw_db = open_db<int_trait>(pairs);
+
+    std::vector<unsigned int> expected_keys;
+    long expected_sum{};
+    for (auto const &[key, value] : pairs) {
+        expected_keys.push_back(key);
+        expected_sum += value;
+    }
+
+    std::vector<unsigned int> const boundaries{100, 1500, 2990};
+    auto const keys = lmdb::parallel_scan(
+        rw_db,
+        boundaries,
+        std::vector<unsigned int>{},
+        collect_keys,
+        concatenate);
+    ASSERT_TRUE(keys);
+    EXPECT_EQ(*keys, expected_keys);
+
+    auto const sum = lmdb::parallel_scan(
+        rw_db,
+        boundaries,
+        0L,
+        [](auto &view) {
+            long partial{};
+            for (auto const &item : view)
+                partial += item.value();
+            return partial;
+        },
+        [](long const lhs, long const rhs) { return lhs + rhs; });
+    ASSERT_TRUE(sum);
+    EXPECT_EQ(*sum, expected_sum);
+}
+
+TEST_F(parallel_scan_test, sampled_integer_keys)
+{
+    auto const pairs = int_pairs(1000);
+    auto rw_db = open_db<int_trait>(pairs);
+
+    std::vector<unsigned int> expected_keys;
+    for (auto const &pair : pairs)
+        expected_keys.push_back(pair.first);
+
+    auto const split_points = lmdb::details::sample_split_points(rw_db, 8);
+    ASSERT_TRUE(split_points);
+    EXPECT_EQ(split_points->size(), 7);
+
+    auto const keys = lmdb::parallel_scan(
+        rw_db, 8, std::vector<unsigned int>{}, collect_keys, concatenate);
+    ASSERT_TRUE(keys);
+    EXPECT_EQ(*keys, expected_keys);
+}
+
+TEST_F(parallel_scan_test, sampled_string_keys)
+{
+    std::vector<std::pair<std::string, int>> pairs;
+    for (int i = 0; i < 500; ++i) {
+        char key[16];
+        std::snprintf(key, sizeof(key), "key%04d", i);
+        pairs.emplace_back(key, i);
+    }
+    auto rw_db = open_db<string_trait>(pairs);
+
+    std::vector<std::string> expected_keys;
+    for (auto const &pair : pairs)
+        expected_keys.push_back(pair.first);
+
+    auto const split_points = lmdb::details::sample_split_points(rw_db, 4);
+    ASSERT_TRUE(split_points);
+    EXPECT_EQ(split_points->size(), 3);
+
+    auto const keys = lmdb::parallel_scan(
+        rw_db, 4, std::vector<std::string>{}, collect_keys, concatenate);
+    ASSERT_TRUE(keys);
+    EXPECT_EQ(*keys, expected_keys);
+}
+
+TEST_F(parallel_scan_test, empty_db_and_map_exception)
+{
+    auto rw_db = open_db<int_trait>(int_pairs(0));
+
+    auto const count = lmdb::parallel_scan(
+        rw_db,
+        4,
+        0,
+        [](auto &view) {
+            return static_cast<int>(std::ranges::distance(view));
+        },
+        [](int const lhs, int const rhs) { return lhs + rhs; });
+    ASSERT_TRUE(count);
+    EXPECT_EQ(*count, 0);
+
+    std::vector<unsigned int> const boundaries{10};
+    EXPECT_THROW(
+        (void)lmdb::parallel_scan(
+            rw_db,
+            boundaries,
+            0,
+            [](auto &) -> int { throw std::runtime_error{"map failed"}; },
+            [](int const lhs, int const rhs) { return lhs + rhs; }),
+        std::runtime_error);
+}
+
+}  // namespace cpp_lmdb_tests
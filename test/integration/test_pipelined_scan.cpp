@@ -0,0 +1,110 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <atomic>
+#include <filesystem>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using test_trait = lmdb::
+    unique_key<lmdb::trivial_trait<unsigned int>, lmdb::trivial_trait<int>>;
+
+class pipelined_scan_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+
+        _environment.emplace(
+            lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+                test_env, lmdb::default_file_mode)
+                .value());
+        _db.emplace(_environment
+                        ->open_rw_db<test_trait>(
+                            "test_db", lmdb::create_if_not_exists::yes)
+                        .value());
+
+        std::vector<std::pair<unsigned int, int>> pairs;
+        for (unsigned int i = 0; i < item_count; ++i)
+            pairs.emplace_back(i, static_cast<int>(i) * 2);
+        ASSERT_TRUE(_db->bulk_load(pairs));
+    }
+
+    auto db() -> lmdb::rw_environment<>::rw_db<test_trait> &
+    {
+        return *_db;
+    }
+
+    constexpr static auto test_env = "./test_env_pipelined_scan";
+    constexpr static unsigned int item_count{5000};
+
+private:
+    std::optional<lmdb::rw_environment<>> _environment;
+    std::optional<lmdb::rw_environment<>::rw_db<test_trait>> _db;
+};
+
+TEST_F(pipelined_scan_test, unordered)
+{
+    std::atomic<long> sum{};
+    std::atomic<size_t> calls{};
+
+    auto const count = lmdb::pipelined_scan(
+        db(),
+        [&](unsigned int const key, int const value) {
+            EXPECT_EQ(value, static_cast<int>(key) * 2);
+            sum.fetch_add(value, std::memory_order_relaxed);
+            calls.fetch_add(1, std::memory_order_relaxed);
+        },
+        {.worker_count = 4, .ring_capacity = 8});
+
+    ASSERT_TRUE(count);
+    EXPECT_EQ(*count, item_count);
+    EXPECT_EQ(calls, item_count);
+    EXPECT_EQ(sum, long{item_count} * (item_count - 1));
+}
+
+TEST_F(pipelined_scan_test, ordered)
+{
+    std::vector<unsigned int> keys;
+
+    auto const count = lmdb::pipelined_scan(
+        db(),
+        [&keys](unsigned int const key, int) { keys.push_back(key); },
+        {.worker_count = 3, .ring_capacity = 2, .ordered = true});
+
+    ASSERT_TRUE(count);
+    EXPECT_EQ(*count, item_count);
+    ASSERT_EQ(keys.size(), item_count);
+    for (unsigned int i = 0; i < item_count; ++i)
+        EXPECT_EQ(keys[i], i);
+}
+
+TEST_F(pipelined_scan_test, callback_exception_stops_the_scan)
+{
+    for (auto const ordered : {false, true}) {
+        EXPECT_THROW(
+            (void)lmdb::pipelined_scan(
+                db(),
+                [](unsigned int const key, int) {
+                    if (key == 100)
+                        throw std::runtime_error{"callback failed"};
+                },
+                {.ordered = ordered}),
+            std::runtime_error);
+    }
+}
+
+}  // namespace cpp_lmdb_tests
@@ -0,0 +1,240 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+#include "test_utils.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <filesystem>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using unique_trait = lmdb::
+    unique_key<lmdb::trivial_trait<unsigned int>, lmdb::trivial_trait<int>>;
+using dup_trait = lmdb::
+    duplicate_key<lmdb::trivial_trait<unsigned int>, lmdb::trivial_trait<int>>;
+
+namespace
+{
+template <typename View>
+auto get_all_keys(View const &view)
+{
+    return to_vector(
+        std::ranges::ref_view{view}
+        | std::views::transform([](auto const &item) { return item.key(); }));
+}
+}  // namespace
+
+class range_iteration_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+    }
+
+    template <typename Trait>
+    auto open_db(std::vector<std::pair<unsigned int, int>> const &pairs)
+    {
+        _environment.emplace(
+            lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+                test_env, lmdb::default_file_mode)
+                .value());
+
+        auto rw_db = _environment
+                         ->open_rw_db<Trait>(
+                             "test_db", lmdb::create_if_not_exists::yes)
+                         .value();
+        EXPECT_TRUE(rw_db.bulk_load(pairs));
+        return rw_db;
+    }
+
+    constexpr static auto test_env = "./test_env_range_iteration";
+
+private:
+    std::optional<lmdb::rw_environment<>> _environment;
+};
+
+TEST_F(range_iteration_test, forward_ranges)
+{
+    auto rw_db = open_db<unique_trait>(
+        {{10, 1}, {20, 2}, {30, 3}, {40, 4}, {50, 5}});
+    auto ro_tx = rw_db.begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_from(25).value()),
+        ElementsAre(30, 40, 50));
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_from(30).value()),
+        ElementsAre(30, 40, 50));
+    EXPECT_THAT(get_all_keys(ro_tx->iterate_from(51).value()), IsEmpty());
+
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_range(20, 50).value()),
+        ElementsAre(20, 30, 40));
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_range(15, 45).value()),
+        ElementsAre(20, 30, 40));
+    EXPECT_THAT(get_all_keys(ro_tx->iterate_range(21, 29).value()), IsEmpty());
+    EXPECT_THAT(
+        get_all_values(ro_tx->iterate_range(0, 100).value()),
+        ElementsAre(1, 2, 3, 4, 5));
+}
+
+TEST_F(range_iteration_test, reverse_ranges)
+{
+    auto rw_db = open_db<unique_trait>(
+        {{10, 1}, {20, 2}, {30, 3}, {40, 4}, {50, 5}});
+    auto ro_tx = rw_db.begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_reverse().value()),
+        ElementsAre(50, 40, 30, 20, 10));
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_range_reverse(20, 50).value()),
+        ElementsAre(40, 30, 20));
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_range_reverse(15, 100).value()),
+        ElementsAre(50, 40, 30, 20));
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_range_reverse(0, 10).value()), IsEmpty());
+}
+
+TEST_F(range_iteration_test, seek)
+{
+    auto rw_db = open_db<unique_trait>(
+        {{10, 1}, {20, 2}, {30, 3}, {40, 4}, {50, 5}});
+    auto ro_tx = rw_db.begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+
+    {
+        auto const view = ro_tx->iterate_range(20, 50);
+        ASSERT_TRUE(view);
+        auto it = view->begin();
+        ASSERT_NE(it, view->end());
+        EXPECT_EQ((*it).key(), 20);
+
+        it.seek(35);
+        ASSERT_NE(it, view->end());
+        EXPECT_EQ((*it).key(), 40);
+
+        it.seek(0);
+        ASSERT_NE(it, view->end());
+        EXPECT_EQ((*it).key(), 20);
+
+        it.seek(50);
+        EXPECT_EQ(it, view->end());
+    }
+    {
+        auto const view = ro_tx->iterate_range_reverse(20, 50);
+        ASSERT_TRUE(view);
+        auto it = view->begin();
+        ASSERT_NE(it, view->end());
+        EXPECT_EQ((*it).key(), 40);
+
+        it.seek(35);
+        ASSERT_NE(it, view->end());
+        EXPECT_EQ((*it).key(), 30);
+
+        it.seek(30);
+        ASSERT_NE(it, view->end());
+        EXPECT_EQ((*it).key(), 30);
+        ++it;
+        EXPECT_EQ((*it).key(), 20);
+
+        it.seek(100);
+        ASSERT_NE(it, view->end());
+        EXPECT_EQ((*it).key(), 40);
+
+        it.seek(15);
+        EXPECT_EQ(it, view->end());
+    }
+}
+
+TEST_F(range_iteration_test, reverse_duplicates)
+{
+    auto rw_db = open_db<dup_trait>(
+        {{10, 1}, {10, 2}, {20, 3}, {20, 4}, {30, 5}});
+    auto ro_tx = rw_db.begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+
+    EXPECT_THAT(
+        get_all_values(ro_tx->iterate_reverse().value()),
+        ElementsAre(5, 4, 3, 2, 1));
+    EXPECT_THAT(
+        get_all_values(ro_tx->iterate_range_reverse(10, 30).value()),
+        ElementsAre(4, 3, 2, 1));
+
+    auto const view = ro_tx->iterate_reverse();
+    ASSERT_TRUE(view);
+    auto it = view->begin();
+    it.seek(20);
+    ASSERT_NE(it, view->end());
+    EXPECT_EQ((*it).value(), 4);
+    EXPECT_EQ((*it).key(), 20);
+}
+
+template <typename T>
+concept has_iterate_prefix_v
+    = requires(T t) { t.iterate_prefix(std::declval<unsigned int>()); };
+
+TEST_F(range_iteration_test, string_prefix)
+{
+    using string_trait
+        = lmdb::unique_key<lmdb::string_trait, lmdb::trivial_trait<int>>;
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<string_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    ASSERT_TRUE(rw_db->write(
+        [](auto &txn) -> std::expected<void, lmdb::error_t> {
+            for (auto const *key :
+                 {"tenant1/a",
+                  "tenant1/b/c",
+                  "tenant10/a",
+                  "tenant2/a",
+                  "tenant/a"}) {
+                if (auto const result = txn.insert(key, 0); !result)
+                    return result;
+            }
+            return {};
+        }));
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+
+    static_assert(!has_iterate_prefix_v<lmdb::transaction<
+                      unique_trait,
+                      lmdb::read_only_t::yes,
+                      lmdb::details::api>>);
+
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_prefix("tenant1/").value()),
+        ElementsAre("tenant1/a", "tenant1/b/c"));
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_prefix("tenant1").value()),
+        ElementsAre("tenant1/a", "tenant1/b/c", "tenant10/a"));
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_prefix("tenant3").value()), IsEmpty());
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_prefix("zzz").value()), IsEmpty());
+    EXPECT_EQ(get_all_keys(ro_tx->iterate_prefix("").value()).size(), 5);
+}
+
+}  // namespace cpp_lmdb_tests
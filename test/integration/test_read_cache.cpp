@@ -0,0 +1,144 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+#include "test_utils.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using cached_trait
+    = lmdb::unique_key<lmdb::trivial_trait<uint32_t>, lmdb::string_trait>;
+using read_cache = lmdb::read_cache<cached_trait, lmdb::details::api>;
+
+class read_cache_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+
+        _environment.emplace(
+            lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+                test_env, lmdb::default_file_mode)
+                .value());
+        _db.emplace(_environment
+                        ->open_rw_db<cached_trait>(
+                            "cached", lmdb::create_if_not_exists::yes)
+                        .value());
+    }
+
+    auto put(uint32_t const key, std::string const &value) -> void
+    {
+        auto txn = _db->begin_rw_transaction().value();
+        EXPECT_TRUE(txn.insert(key, value));
+        EXPECT_TRUE(_db->commit_transaction(std::move(txn)));
+    }
+
+    constexpr static auto test_env = "./test_env_read_cache";
+
+    std::optional<lmdb::rw_environment<>> _environment;
+    std::optional<lmdb::rw_environment<>::rw_db<cached_trait>> _db;
+};
+
+TEST_F(read_cache_test, commits_invalidate_written_keys)
+{
+    put(1, "one");
+    put(2, "two");
+
+    read_cache cache{*_db};
+    EXPECT_EQ(cache.get(1).value(), "one");
+    EXPECT_EQ(cache.get(1).value(), "one");
+    EXPECT_EQ(cache.get(2).value(), "two");
+    EXPECT_EQ(cache.get(3).error(), lmdb::error_t::not_found);
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 3);
+
+    // pins the snapshot before the write
+    auto const old_txn = _db->begin_ro_transaction().value();
+
+    put(1, "uno");
+    stats = cache.stats();
+    EXPECT_EQ(stats.invalidations, 1);
+
+    EXPECT_EQ(cache.get(1).value(), "uno");
+    EXPECT_EQ(cache.get(2).value(), "two");
+    EXPECT_EQ(cache.stats().hits, 2);
+
+    // entries newer than the snapshot are not used, nor is the old value
+    // inserted
+    EXPECT_EQ(cache.get(old_txn, 1).value(), "one");
+    EXPECT_EQ(cache.get(1).value(), "uno");
+
+    // deletes and nested transactions report their keys too
+    {
+        auto txn = _db->begin_rw_transaction().value();
+        EXPECT_TRUE(txn.delete_key(2));
+        auto nested = txn.begin_nested().value();
+        EXPECT_TRUE(nested.insert(1, "eins"));
+        EXPECT_TRUE(txn.merge_nested(std::move(nested)));
+        EXPECT_TRUE(_db->commit_transaction(std::move(txn)));
+    }
+    EXPECT_EQ(cache.get(1).value(), "eins");
+    EXPECT_EQ(cache.get(2).error(), lmdb::error_t::not_found);
+}
+
+TEST_F(read_cache_test, unreported_commits_drop_the_cache)
+{
+    put(1, "one");
+
+    auto const ro_db
+        = _environment->open_ro_db<cached_trait>("cached").value();
+    read_cache cache{ro_db};
+    {
+        auto const txn = ro_db.begin_ro_transaction().value();
+        EXPECT_EQ(cache.get(txn, 1).value(), "one");
+        EXPECT_EQ(cache.get(txn, 1).value(), "one");
+    }
+
+    put(1, "uno");
+
+    auto const txn = ro_db.begin_ro_transaction().value();
+    EXPECT_EQ(cache.get(txn, 1).value(), "uno");
+    auto const stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.invalidations, 1);
+}
+
+TEST_F(read_cache_test, byte_budget_evicts_unreferenced_entries)
+{
+    for (uint32_t key = 0; key < 8; ++key)
+        put(key, std::string(100, static_cast<char>('a' + key)));
+
+    // room for three entries of about 200 bytes in a single shard
+    read_cache cache{*_db, {.shard_count = 1, .byte_budget = 700}};
+    for (uint32_t key = 0; key < 3; ++key)
+        EXPECT_TRUE(cache.get(key));
+    EXPECT_TRUE(cache.get(0));
+
+    // 0 was referenced, so 1 and 2 are evicted first
+    EXPECT_TRUE(cache.get(3));
+    EXPECT_TRUE(cache.get(4));
+    EXPECT_EQ(cache.stats().evictions, 2);
+
+    auto const hits = cache.stats().hits;
+    EXPECT_EQ(cache.get(0).value(), std::string(100, 'a'));
+    EXPECT_EQ(cache.stats().hits, hits + 1);
+    EXPECT_EQ(cache.get(1).value(), std::string(100, 'b'));
+    EXPECT_EQ(cache.stats().hits, hits + 1);
+}
+
+}  // namespace cpp_lmdb_tests
@@ -0,0 +1,57 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <filesystem>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using test_trait = lmdb::
+    unique_key<lmdb::trivial_trait<unsigned int>, lmdb::trivial_trait<int>>;
+
+TEST(integration_test, pooled_ro_transaction_sees_latest_commit)
+{
+    constexpr auto test_env = "./test_env_ro_txn_pool";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    auto pool = environment->make_ro_txn_pool(4);
+
+    for (int value = 1; value <= 3; ++value) {
+        {
+            auto transaction = rw_db->begin_rw_transaction();
+            ASSERT_TRUE(transaction);
+            ASSERT_TRUE(transaction->insert(1, value));
+            ASSERT_TRUE(rw_db->commit_transaction(std::move(*transaction)));
+        }
+
+        auto const ro_tx = rw_db->begin_ro_transaction(pool);
+        ASSERT_TRUE(ro_tx);
+
+        auto const result = ro_tx->get(1);
+        ASSERT_TRUE(result);
+        EXPECT_EQ(*result, value);
+    }
+
+    auto const stats = pool.stats();
+    EXPECT_EQ(stats.misses, 1);
+    EXPECT_EQ(stats.hits, 2);
+}
+
+}  // namespace cpp_lmdb_tests
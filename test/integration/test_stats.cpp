@@ -0,0 +1,82 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using test_trait
+    = lmdb::unique_key<lmdb::trivial_trait<uint32_t>, lmdb::string_trait>;
+
+TEST(integration_test, env_and_db_stats)
+{
+    constexpr auto test_env = "./test_env_stats";
+
+    if (std::filesystem::exists(test_env))
+        std::filesystem::remove_all(test_env);
+    std::filesystem::create_directory(test_env);
+
+    constexpr size_t map_size{size_t{16} << 20U};
+
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env,
+        lmdb::default_file_mode,
+        lmdb::env_options_t{.map_size = map_size, .max_readers = 20});
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    auto const before = environment->info().value();
+    EXPECT_EQ(before.map_size, map_size);
+    EXPECT_EQ(before.max_readers, 20);
+    EXPECT_GT(before.page_size, 0);
+
+    {
+        auto txn = rw_db->begin_rw_transaction().value();
+        for (uint32_t key = 0; key < 2000; ++key)
+            ASSERT_TRUE(txn.insert(key, std::to_string(key)));
+        ASSERT_TRUE(txn.insert(5000, std::string(5 * before.page_size, 'x')));
+
+        // uncommitted writes are counted by the writing transaction
+        EXPECT_EQ(txn.size().value(), 2001);
+        EXPECT_EQ(rw_db->stats().value().entries, 0);
+        ASSERT_TRUE(rw_db->commit_transaction(std::move(txn)));
+    }
+
+    auto const stats = rw_db->stats().value();
+    EXPECT_EQ(stats.entries, 2001);
+    EXPECT_EQ(stats.page_size, before.page_size);
+    EXPECT_GE(stats.depth, 2);
+    EXPECT_GE(stats.branch_pages, 1);
+    EXPECT_GT(stats.leaf_pages, 1);
+    EXPECT_GE(stats.overflow_pages, 5);
+
+    // the main db holds the name of the named db
+    EXPECT_EQ(environment->stats().value().entries, 1);
+
+    auto const ro_txn = rw_db->begin_ro_transaction().value();
+    EXPECT_EQ(ro_txn.size().value(), 2001);
+
+    auto const after = environment->info().value();
+    EXPECT_EQ(after.last_txn_id, before.last_txn_id + 1);
+    EXPECT_GT(after.last_page, before.last_page);
+    EXPECT_GE(after.used_readers, 1);
+    EXPECT_LE(after.used_size(), after.map_size);
+    EXPECT_GE(
+        after.used_size(),
+        (stats.branch_pages + stats.leaf_pages + stats.overflow_pages)
+            * stats.page_size);
+}
+
+}  // namespace cpp_lmdb_tests
@@ -0,0 +1,193 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+#include "test_utils.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <algorithm>
+#include <cstdint>
+#include <expected>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using event_key_trait = lmdb::
+    tuple_key_trait<uint32_t, lmdb::descending<int64_t>, std::string>;
+using event_key = event_key_trait::value_type;
+
+namespace
+{
+template <typename View>
+auto get_all_keys(View const &view)
+{
+    return to_vector(
+        std::ranges::ref_view{view}
+        | std::views::transform([](auto const &item) { return item.key(); }));
+}
+}  // namespace
+
+class tuple_keys_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+
+        _environment.emplace(
+            lmdb::make_environment<lmdb::env_flags_t::none, 4>(
+                test_env, lmdb::default_file_mode)
+                .value());
+    }
+
+    // opens a db of the given key trait holding the keys
+    template <typename KeyTrait>
+    auto store(
+        char const *const name,
+        std::vector<typename KeyTrait::value_type> const &keys)
+    {
+        using trait = lmdb::unique_key<KeyTrait, lmdb::trivial_trait<int>>;
+
+        auto rw_db = _environment
+                         ->open_rw_db<trait>(
+                             name, lmdb::create_if_not_exists::yes)
+                         .value();
+        auto txn = rw_db.begin_rw_transaction().value();
+        for (auto const &key : keys)
+            EXPECT_TRUE(txn.insert(key, 0));
+        EXPECT_TRUE(rw_db.commit_transaction(std::move(txn)));
+        return rw_db;
+    }
+
+    constexpr static auto test_env = "./test_env_tuple_keys";
+
+private:
+    std::optional<lmdb::rw_environment<>> _environment;
+};
+
+TEST_F(tuple_keys_test, components_sort_in_natural_order)
+{
+    std::vector<std::tuple<int64_t>> const ints{
+        {std::numeric_limits<int64_t>::max()},
+        {0},
+        {-1},
+        {std::numeric_limits<int64_t>::min()},
+        {1}};
+    std::vector<std::tuple<double>> const doubles{
+        {std::numeric_limits<double>::infinity()},
+        {-1.5},
+        {0.0},
+        {1e-300},
+        {-std::numeric_limits<double>::infinity()},
+        {-1e-300},
+        {2.0}};
+    std::vector<std::tuple<std::string>> const strings{
+        {"b"},
+        {std::string{"a\0b", 3}},
+        {"ab"},
+        {""},
+        {"a"},
+        {std::string{"a\0", 2}},
+        {"\xff"}};
+
+    auto sorted = [](auto values) {
+        std::ranges::sort(values);
+        return values;
+    };
+
+    {
+        auto const db
+            = store<lmdb::tuple_key_trait<int64_t>>("ints", ints);
+        EXPECT_EQ(
+            get_all_keys(db.begin_ro_transaction()->iterate().value()),
+            sorted(ints));
+    }
+    {
+        auto const db
+            = store<lmdb::tuple_key_trait<double>>("doubles", doubles);
+        EXPECT_EQ(
+            get_all_keys(db.begin_ro_transaction()->iterate().value()),
+            sorted(doubles));
+    }
+    {
+        auto const db
+            = store<lmdb::tuple_key_trait<std::string>>("strings", strings);
+        EXPECT_EQ(
+            get_all_keys(db.begin_ro_transaction()->iterate().value()),
+            sorted(strings));
+    }
+}
+
+TEST_F(tuple_keys_test, composite_keys)
+{
+    std::vector<event_key> const keys{
+        {2, 100, "b"},
+        {1, 100, "a"},
+        {1, -5, "a"},
+        {1, 200, "a"},
+        {1, 100, "b"},
+        {2, 300, ""},
+        {10, 0, "z"}};
+    auto const db = store<event_key_trait>("events", keys);
+    auto ro_tx = db.begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+
+    // tenants ascending, timestamps descending, sequences ascending
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate().value()),
+        ElementsAre(
+            event_key{1, 200, "a"},
+            event_key{1, 100, "a"},
+            event_key{1, 100, "b"},
+            event_key{1, -5, "a"},
+            event_key{2, 300, ""},
+            event_key{2, 100, "b"},
+            event_key{10, 0, "z"}));
+
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_prefix(1U).value()),
+        ElementsAre(
+            event_key{1, 200, "a"},
+            event_key{1, 100, "a"},
+            event_key{1, 100, "b"},
+            event_key{1, -5, "a"}));
+    EXPECT_THAT(
+        get_all_keys(ro_tx->iterate_prefix(1U, int64_t{100}).value()),
+        ElementsAre(event_key{1, 100, "a"}, event_key{1, 100, "b"}));
+    EXPECT_THAT(get_all_keys(ro_tx->iterate_prefix(3U).value()), IsEmpty());
+
+    EXPECT_THAT(
+        get_all_keys(ro_tx
+                         ->iterate_range(
+                             event_key{1, 100, ""},
+                             event_key{2, std::numeric_limits<int64_t>::max(),
+                                       ""})
+                         .value()),
+        ElementsAre(
+            event_key{1, 100, "a"},
+            event_key{1, 100, "b"},
+            event_key{1, -5, "a"}));
+
+    std::vector<std::expected<int, lmdb::error_t>> results(keys.size() + 1);
+    auto lookups = keys;
+    lookups.push_back({5, 5, "missing"});
+    ASSERT_TRUE(ro_tx->get_many(lookups, results));
+    for (size_t i = 0; i < keys.size(); ++i)
+        EXPECT_TRUE(results[i]);
+    ASSERT_FALSE(results.back());
+    EXPECT_EQ(results.back().error(), lmdb::error_t::not_found);
+}
+
+}  // namespace cpp_lmdb_tests
@@ -0,0 +1,168 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <filesystem>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+namespace cpp_lmdb_tests
+{
+
+using test_trait = lmdb::
+    unique_key<lmdb::trivial_trait<unsigned int>, lmdb::trivial_trait<int>>;
+
+class write_coordinator_test : public Test {
+protected:
+    void SetUp() override
+    {
+        if (std::filesystem::exists(test_env))
+            std::filesystem::remove_all(test_env);
+        std::filesystem::create_directory(test_env);
+    }
+
+    constexpr static auto test_env = "./test_env_write_coordinator";
+};
+
+TEST_F(write_coordinator_test, concurrent_writes_committed_in_batches)
+{
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    using coordinator_t
+        = lmdb::write_coordinator<test_trait, lmdb::details::api>;
+
+    constexpr unsigned int thread_count{8};
+    constexpr unsigned int writes_per_thread{100};
+
+    {
+        coordinator_t coordinator{
+            *rw_db,
+            lmdb::write_coordinator_options_t{
+                .max_batch_size = 32,
+                .max_batch_delay = std::chrono::microseconds{200}}};
+
+        std::vector<std::jthread> producers;
+        for (unsigned int thread = 0; thread < thread_count; ++thread) {
+            producers.emplace_back([&coordinator, thread] {
+                std::vector<std::future<coordinator_t::result_type>> results;
+                for (unsigned int i = 0; i < writes_per_thread; ++i) {
+                    auto const key = thread * writes_per_thread + i;
+                    results.push_back(coordinator.submit(
+                        [key](coordinator_t::rw_transaction &txn) {
+                            return txn.insert(key, static_cast<int>(key));
+                        }));
+                }
+
+                for (auto &result : results)
+                    EXPECT_TRUE(result.get());
+            });
+        }
+        producers.clear();
+
+        auto const stats = coordinator.stats();
+        EXPECT_EQ(stats.operations, thread_count * writes_per_thread);
+        EXPECT_LE(stats.max_batch_size, 32);
+        EXPECT_GE(stats.batches, stats.operations / 32);
+    }
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+    for (unsigned int key = 0; key < thread_count * writes_per_thread; ++key)
+        EXPECT_EQ(ro_tx->get(key).value_or(-1), static_cast<int>(key));
+}
+
+TEST_F(write_coordinator_test, failed_operation_does_not_fail_batch)
+{
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    using coordinator_t
+        = lmdb::write_coordinator<test_trait, lmdb::details::api>;
+
+    std::future<coordinator_t::result_type> first;
+    std::future<coordinator_t::result_type> duplicate;
+    std::future<coordinator_t::result_type> second;
+    {
+        coordinator_t coordinator{
+            *rw_db,
+            lmdb::write_coordinator_options_t{
+                .max_batch_delay = std::chrono::milliseconds{10}}};
+
+        first = coordinator.submit([](coordinator_t::rw_transaction &txn) {
+            return txn.try_insert(1, 1);
+        });
+        duplicate
+            = coordinator.submit([](coordinator_t::rw_transaction &txn) {
+                  auto const result = txn.insert(2, 0);
+                  if (!result)
+                      return result;
+                  return txn.try_insert(1, 0);
+              });
+        second = coordinator.submit([](coordinator_t::rw_transaction &txn) {
+            return txn.try_insert(3, 3);
+        });
+    }
+
+    EXPECT_TRUE(first.get());
+    auto const duplicate_result = duplicate.get();
+    ASSERT_FALSE(duplicate_result);
+    EXPECT_EQ(duplicate_result.error(), lmdb::error_t::key_exist);
+    EXPECT_TRUE(second.get());
+
+    auto ro_tx = rw_db->begin_ro_transaction();
+    ASSERT_TRUE(ro_tx);
+    EXPECT_EQ(ro_tx->get(1).value_or(-1), 1);
+    EXPECT_FALSE(ro_tx->get(2));
+    EXPECT_EQ(ro_tx->get(3).value_or(-1), 3);
+}
+
+TEST_F(write_coordinator_test, zero_batch_size_commits_single_operations)
+{
+    auto environment = lmdb::make_environment<lmdb::env_flags_t::none, 1>(
+        test_env, lmdb::default_file_mode);
+    ASSERT_TRUE(environment);
+
+    auto rw_db = environment->open_rw_db<test_trait>(
+        "test_db", lmdb::create_if_not_exists::yes);
+    ASSERT_TRUE(rw_db);
+
+    using coordinator_t
+        = lmdb::write_coordinator<test_trait, lmdb::details::api>;
+
+    coordinator_t coordinator{
+        *rw_db, lmdb::write_coordinator_options_t{.max_batch_size = 0}};
+
+    std::vector<std::future<coordinator_t::result_type>> results;
+    for (unsigned int key = 0; key < 4; ++key) {
+        results.push_back(
+            coordinator.submit([key](coordinator_t::rw_transaction &txn) {
+                return txn.insert(key, static_cast<int>(key));
+            }));
+    }
+    for (auto &result : results)
+        EXPECT_TRUE(result.get());
+
+    auto const stats = coordinator.stats();
+    EXPECT_EQ(stats.operations, 4);
+    EXPECT_EQ(stats.batches, 4);
+    EXPECT_EQ(stats.max_batch_size, 1);
+}
+
+}  // namespace cpp_lmdb_tests
@@ -27,7 +27,16 @@ struct api {
         (const));
     MOCK_METHOD(void, mdb_txn_abort, (MDB_txn *), (const));
     MOCK_METHOD(int, mdb_txn_commit, (MDB_txn *), (const));
+    MOCK_METHOD(void, mdb_txn_reset, (MDB_txn *), (const));
+    MOCK_METHOD(int, mdb_txn_renew, (MDB_txn *), (const));
+    MOCK_METHOD(MDB_env *, mdb_txn_env, (MDB_txn *), (const));
+    MOCK_METHOD(size_t, mdb_txn_id, (MDB_txn *), (const));
     MOCK_METHOD(int, mdb_env_set_maxdbs, (MDB_env *, MDB_dbi), (const));
+    MOCK_METHOD(int, mdb_env_set_mapsize, (MDB_env *, size_t), (const));
+    MOCK_METHOD(
+        int, mdb_env_set_maxreaders, (MDB_env *, unsigned int), (const));
+    MOCK_METHOD(int, mdb_env_info, (MDB_env *, MDB_envinfo *), (const));
+    MOCK_METHOD(int, mdb_env_stat, (MDB_env *, MDB_stat *), (const));
     MOCK_METHOD(
         int,
         mdb_dbi_open,
@@ -35,6 +44,7 @@ struct api {
         (const));
 
     MOCK_METHOD(int, mdb_drop, (MDB_txn *, MDB_dbi, int), (const));
+    MOCK_METHOD(int, mdb_stat, (MDB_txn *, MDB_dbi, MDB_stat *), (const));
 
     MOCK_METHOD(
         int, mdb_set_compare, (MDB_txn *, MDB_dbi, MDB_cmp_func), (const));
@@ -49,14 +59,25 @@ struct api {
         int, mdb_get, (MDB_txn *, MDB_dbi, MDB_val *, MDB_val *), (const));
     MOCK_METHOD(
         int, mdb_del, (MDB_txn *, MDB_dbi, MDB_val *, MDB_val *), (const));
+    MOCK_METHOD(
+        int,
+        mdb_cmp,
+        (MDB_txn *, MDB_dbi, MDB_val const *, MDB_val const *),
+        (const));
     MOCK_METHOD(
         int, mdb_cursor_open, (MDB_txn *, MDB_dbi, MDB_cursor **), (const));
     MOCK_METHOD(void, mdb_cursor_close, (MDB_cursor *), (const));
+    MOCK_METHOD(int, mdb_cursor_renew, (MDB_txn *, MDB_cursor *), (const));
     MOCK_METHOD(
         int,
         mdb_cursor_get,
         (MDB_cursor *, MDB_val *, MDB_val *, MDB_cursor_op),
         (const));
+    MOCK_METHOD(
+        int,
+        mdb_cursor_put,
+        (MDB_cursor *, MDB_val *, MDB_val *, unsigned int),
+        (const));
 
     // NOLINTEND(modernize-use-trailing-return-type)
 };
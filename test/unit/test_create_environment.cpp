@@ -170,4 +170,88 @@ TEST(test_create_environment, env_open_failed)
     EXPECT_EQ(env.error(), lmdb::error_t::bad_valsize);
 }
 
+TEST(test_create_environment, environment_with_options_created_and_released)
+{
+    StrictMock<mocks::api> api;
+
+    MDB_env *test_env{reinterpret_cast<MDB_env *>(0x42)};
+
+    constexpr auto test_env_path = "env path";
+    constexpr size_t test_max_db_count{1};
+    constexpr lmdb::db_file_mode_t test_file_mode{0x42};
+    constexpr lmdb::env_options_t test_options{
+        .map_size = size_t{1} << 30, .max_readers = 512};
+
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_env_create(_))
+            .WillOnce(DoAll(SetArgPointee<0>(test_env), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_env_set_maxdbs(test_env, test_max_db_count));
+        EXPECT_CALL(api, mdb_env_set_mapsize(test_env, test_options.map_size))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(
+            api, mdb_env_set_maxreaders(test_env, test_options.max_readers))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(
+            api,
+            mdb_env_open(
+                test_env,
+                StrEq(test_env_path),
+                MDB_WRITEMAP | MDB_MAPASYNC | MDB_NOMETASYNC | MDB_NORDAHEAD,
+                test_file_mode))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(api, mdb_env_close(test_env));
+    }
+
+    auto const env = lmdb::make_environment<
+        lmdb::env_flags_t::write_map | lmdb::env_flags_t::map_async
+            | lmdb::env_flags_t::no_meta_sync
+            | lmdb::env_flags_t::no_read_ahead,
+        test_max_db_count>(test_env_path, test_file_mode, test_options, api);
+
+    ASSERT_TRUE(env);
+}
+
+TEST(test_create_environment, set_map_size_failed)
+{
+    StrictMock<mocks::api> api;
+
+    MDB_env *test_env{reinterpret_cast<MDB_env *>(0x42)};
+
+    constexpr auto test_env_path = "env path";
+    constexpr size_t test_max_db_count{1};
+
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_env_create(_))
+            .WillOnce(DoAll(SetArgPointee<0>(test_env), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_env_set_maxdbs(test_env, test_max_db_count));
+        EXPECT_CALL(api, mdb_env_set_mapsize(test_env, 1))
+            .WillOnce(Return(EINVAL));
+        EXPECT_CALL(api, mdb_env_close(test_env));
+    }
+
+    auto const env
+        = lmdb::make_environment<lmdb::env_flags_t::none, test_max_db_count>(
+            test_env_path,
+            lmdb::default_file_mode,
+            lmdb::env_options_t{.map_size = 1},
+            api);
+
+    ASSERT_FALSE(env);
+    EXPECT_EQ(std::to_underlying(env.error()), EINVAL);
+}
+
+static_assert(lmdb::are_valid_env_flags(
+    lmdb::env_flags_t::no_sync | lmdb::env_flags_t::no_tls));
+static_assert(lmdb::are_valid_env_flags(
+    lmdb::env_flags_t::read_only | lmdb::env_flags_t::no_read_ahead));
+static_assert(!lmdb::are_valid_env_flags(
+    lmdb::env_flags_t::read_only | lmdb::env_flags_t::write_map));
+static_assert(!lmdb::are_valid_env_flags(
+    lmdb::env_flags_t::read_only | lmdb::env_flags_t::no_sync));
+static_assert(!lmdb::are_valid_env_flags(lmdb::env_flags_t::map_async));
+
 }  // namespace cpp_lmdb_tests
@@ -207,4 +207,73 @@ TEST_F(test_create_db, open_rw_db_custom_cmp_fn)
 
     ASSERT_TRUE(db);
 }
+using test_string_trait
+    = lmdb::unique_key<lmdb::string_trait, lmdb::trivial_trait<int>>;
+
+template <typename T>
+constexpr bool db_accessor_has_insert_v
+    = requires(T t) { t.insert(1, 2); };
+
+TEST_F(test_create_db, multi_db_rw_transaction)
+{
+    lmdb::rw_environment<StrictMock<mocks::api> &> environment{std::move(env)};
+
+    using rw_env = decltype(environment);
+    rw_env::rw_db<test_trait> int_db{api, test_dbi, *test_env};
+    rw_env::rw_db<test_string_trait> string_db{api, test_dbi + 1, *test_env};
+
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, 0, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_tx), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_put(test_tx, test_dbi, _, _, 0))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(api, mdb_put(test_tx, test_dbi + 1, _, _, 0))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(api, mdb_txn_commit(test_tx))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(api, mdb_env_close(test_env));
+    }
+
+    auto transaction = environment.begin_rw_transaction(int_db, string_db);
+    ASSERT_TRUE(transaction);
+
+    EXPECT_TRUE(transaction->db<0>().insert(1, 2));
+    EXPECT_TRUE(transaction->db<1>().insert("key", 2));
+
+    EXPECT_TRUE(environment.commit_transaction(std::move(*transaction)));
+}
+
+TEST_F(test_create_db, multi_db_ro_transaction)
+{
+    lmdb::rw_environment<StrictMock<mocks::api> &> environment{std::move(env)};
+
+    using rw_env = decltype(environment);
+    rw_env::rw_db<test_trait> int_db{api, test_dbi, *test_env};
+    rw_env::ro_db<test_string_trait> string_db{api, test_dbi + 1, *test_env};
+
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_tx), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_get(test_tx, test_dbi, _, _))
+            .WillOnce(Return(MDB_NOTFOUND));
+        EXPECT_CALL(api, mdb_get(test_tx, test_dbi + 1, _, _))
+            .WillOnce(Return(MDB_NOTFOUND));
+        EXPECT_CALL(api, mdb_txn_abort(test_tx));
+        EXPECT_CALL(api, mdb_env_close(test_env));
+    }
+
+    auto const transaction
+        = environment.begin_ro_transaction(int_db, string_db);
+    ASSERT_TRUE(transaction);
+
+    static_assert(!db_accessor_has_insert_v<decltype(transaction->db<0>())>);
+
+    EXPECT_FALSE(transaction->db<0>().get(1));
+    EXPECT_FALSE(transaction->db<1>().get("key"));
+}
+
 }  // namespace cpp_lmdb_tests
@@ -0,0 +1,147 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+#include "mocks.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+// std
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace cpp_lmdb_tests
+{
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+using instrumented_mock = lmdb::instrumented_api<StrictMock<mocks::api> &>;
+
+TEST(test_instrumented_api, histogram_buckets)
+{
+    using histogram = lmdb::latency_histogram;
+
+    constexpr std::array<uint64_t, 7> values{
+        0, 15, 16, 17, 1000, 123456, uint64_t{1} << 39U};
+    for (auto const value : values) {
+        auto const bucket = histogram::bucket_of(value);
+        EXPECT_LE(histogram::lower_bound(bucket), value);
+        EXPECT_GT(histogram::lower_bound(bucket + 1), value);
+        EXPECT_LE(
+            (histogram::lower_bound(bucket + 1)
+             - histogram::lower_bound(bucket))
+                * histogram::sub_bucket_count,
+            std::max<uint64_t>(value, histogram::sub_bucket_count));
+    }
+    EXPECT_EQ(
+        histogram::bucket_of(uint64_t{1} << 50U), histogram::bucket_count - 1);
+
+    histogram latencies;
+    for (uint64_t value = 1; value <= 1000; ++value)
+        latencies.record(value * 1000);
+
+    EXPECT_EQ(latencies.count(), 1000);
+    EXPECT_NEAR(latencies.percentile(50), 500'000, 500'000 / 16);
+    EXPECT_NEAR(latencies.percentile(99), 990'000, 990'000 / 16);
+    EXPECT_NEAR(latencies.mean(), 500'500, 500'500 / 16);
+}
+
+TEST(test_instrumented_api, times_calls_and_counts_results)
+{
+    StrictMock<mocks::api> mock;
+    instrumented_mock api{mock};
+
+    auto *const test_env{reinterpret_cast<MDB_env *>(0x41)};
+    auto *const test_txn{reinterpret_cast<MDB_txn *>(0x42)};
+    constexpr MDB_dbi test_dbi{10};
+
+    {
+        InSequence const seq;
+
+        EXPECT_CALL(mock, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(mock, mdb_txn_id(test_txn)).WillOnce(Return(7));
+        EXPECT_CALL(mock, mdb_get(test_txn, test_dbi, _, _))
+            .WillOnce(Return(MDB_NOTFOUND))
+            .WillOnce(Return(MDB_SUCCESS))
+            .WillOnce(Return(EINVAL));
+        EXPECT_CALL(mock, mdb_txn_begin(test_env, nullptr, 0, _))
+            .WillOnce(Return(MDB_READERS_FULL));
+    }
+
+    MDB_txn *txn{};
+    EXPECT_EQ(api.mdb_txn_begin(test_env, nullptr, MDB_RDONLY, &txn), 0);
+    EXPECT_EQ(txn, test_txn);
+    EXPECT_EQ(api.mdb_txn_id(txn), 7);
+
+    MDB_val key{};
+    MDB_val value{};
+    EXPECT_EQ(api.mdb_get(txn, test_dbi, &key, &value), MDB_NOTFOUND);
+    EXPECT_EQ(api.mdb_get(txn, test_dbi, &key, &value), MDB_SUCCESS);
+    EXPECT_EQ(api.mdb_get(txn, test_dbi, &key, &value), EINVAL);
+    EXPECT_EQ(
+        api.mdb_txn_begin(test_env, nullptr, 0, &txn), MDB_READERS_FULL);
+
+    auto const stats = api.snapshot();
+    using lmdb::api_operation;
+
+    EXPECT_EQ(stats[api_operation::ro_txn_begin].calls(), 1);
+    EXPECT_EQ(stats[api_operation::ro_txn_begin].results[0], 1);
+    EXPECT_EQ(stats[api_operation::rw_txn_begin].calls(), 1);
+    EXPECT_EQ(
+        stats[api_operation::rw_txn_begin].errors(
+            lmdb::error_t::readers_full),
+        1);
+
+    auto const &gets = stats[api_operation::get];
+    EXPECT_EQ(gets.calls(), 3);
+    EXPECT_EQ(gets.results[0], 1);
+    EXPECT_EQ(gets.errors(lmdb::error_t::not_found), 1);
+    EXPECT_EQ(gets.results[lmdb::result_slot(EINVAL)], 1);
+    EXPECT_EQ(stats[api_operation::put].calls(), 0);
+
+    // deltas between snapshots
+    EXPECT_CALL(mock, mdb_get(test_txn, test_dbi, _, _))
+        .WillOnce(Return(MDB_SUCCESS));
+    EXPECT_EQ(api.mdb_get(txn, test_dbi, &key, &value), MDB_SUCCESS);
+
+    auto const delta = api.snapshot().since(stats);
+    EXPECT_EQ(delta[api_operation::get].calls(), 1);
+    EXPECT_EQ(delta[api_operation::get].results[0], 1);
+    EXPECT_EQ(delta[api_operation::ro_txn_begin].calls(), 0);
+}
+
+TEST(test_instrumented_api, threads_record_separately)
+{
+    NiceMock<mocks::api> mock;
+    lmdb::instrumented_api<NiceMock<mocks::api> &> api{mock};
+    ON_CALL(mock, mdb_put).WillByDefault(Return(MDB_SUCCESS));
+
+    constexpr size_t thread_count{4};
+    constexpr size_t calls{1000};
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count; ++i) {
+        threads.emplace_back([&api] {
+            for (size_t call = 0; call < calls; ++call)
+                api.mdb_put(nullptr, 0, nullptr, nullptr, 0);
+        });
+    }
+
+    // snapshots may race the calls
+    for (size_t i = 0; i < 10; ++i) {
+        EXPECT_LE(
+            api.snapshot()[lmdb::api_operation::put].calls(),
+            thread_count * calls);
+    }
+
+    for (auto &thread : threads)
+        thread.join();
+
+    auto const puts = api.snapshot()[lmdb::api_operation::put];
+    EXPECT_EQ(puts.calls(), thread_count * calls);
+    EXPECT_EQ(puts.results[0], thread_count * calls);
+}
+
+}  // namespace cpp_lmdb_tests
@@ -1,3 +1,5 @@
+#include "cpp_lmdb/numeric_trait.hpp"
+#include "cpp_lmdb/tuple_key_trait.hpp"
 #include "cpp_lmdb/types.hpp"
 
 // details
@@ -6,6 +8,8 @@
 // std
 #include <cstdint>
 #include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace cpp_lmdb_tests
@@ -85,4 +89,81 @@ static_assert(!lmdb::value_trait<fixed_and_cmp_fn_value_trait>);
 static_assert(
     lmdb::details::has_valid_key_order_params_v<lmdb::trivial_trait<int>>);
 
+static_assert(
+    lmdb::details::key_value_trait_helper<lmdb::duplicate_key<
+        lmdb::trivial_trait<int>,
+        lmdb::fixed_size_trait<int>>>::db_key_value_flags()
+    == (MDB_DUPSORT | MDB_DUPFIXED));
+static_assert(
+    lmdb::details::key_value_trait_helper<lmdb::unique_key<
+        lmdb::trivial_trait<int>,
+        lmdb::fixed_size_trait<int>>>::db_key_value_flags()
+    == 0);
+
+static_assert(lmdb::details::has_view_from_bytes_v<lmdb::string_trait>);
+static_assert(!lmdb::details::has_view_from_bytes_v<lmdb::trivial_trait<int>>);
+static_assert(std::is_same_v<
+              lmdb::details::borrowed_trait<lmdb::string_trait>::value_type,
+              std::string_view>);
+static_assert(std::is_same_v<
+              lmdb::details::borrowed_trait<
+                  lmdb::trivial_trait<int>>::value_type,
+              lmdb::byte_span>);
+
+using tuple_trait = lmdb::
+    tuple_key_trait<uint32_t, lmdb::descending<int64_t>, double, std::string>;
+
+static_assert(lmdb::key_trait<tuple_trait>);
+static_assert(std::is_same_v<
+              tuple_trait::value_type,
+              std::tuple<uint32_t, int64_t, double, std::string>>);
+static_assert(
+    lmdb::details::key_value_trait_helper<
+        lmdb::unique_key<tuple_trait, lmdb::trivial_trait<int>>>::
+        db_key_value_flags()
+    == 0);
+static_assert(!lmdb::details::ordered_encodable<bool>);
+static_assert(!lmdb::details::ordered_encodable<std::string_view>);
+
+template <typename Key, typename Value = lmdb::trivial_trait<int>>
+constexpr auto duplicate_key_flags = lmdb::details::key_value_trait_helper<
+    lmdb::duplicate_key<Key, Value>>::db_key_value_flags();
+
+static_assert(
+    duplicate_key_flags<lmdb::numeric_trait<int64_t>>
+    == (MDB_DUPSORT | MDB_INTEGERKEY));
+static_assert(
+    duplicate_key_flags<lmdb::numeric_trait<float>>
+    == (MDB_DUPSORT | MDB_INTEGERKEY));
+static_assert(
+    duplicate_key_flags<lmdb::numeric_trait<int16_t>>
+    == MDB_DUPSORT);
+static_assert(
+    duplicate_key_flags<lmdb::ordered_numeric_trait<int64_t>>
+    == MDB_DUPSORT);
+static_assert(
+    duplicate_key_flags<
+        lmdb::numeric_trait<uint8_t>,
+        lmdb::numeric_trait<int32_t>>
+    == (MDB_DUPSORT | MDB_INTEGERDUP));
+static_assert(
+    duplicate_key_flags<lmdb::ordered_numeric_trait<uint32_t>>
+    == MDB_DUPSORT);
+static_assert(
+    duplicate_key_flags<lmdb::ordered_numeric_trait<uint64_t>>
+    == MDB_DUPSORT);
+static_assert(
+    duplicate_key_flags<
+        lmdb::trivial_trait<int>,
+        lmdb::ordered_numeric_trait<uint32_t>>
+    == MDB_DUPSORT);
+static_assert(
+    duplicate_key_flags<lmdb::trivial_trait<uint32_t>>
+    == (MDB_DUPSORT | MDB_INTEGERKEY));
+static_assert(
+    duplicate_key_flags<lmdb::numeric_trait<uint32_t>>
+    == (MDB_DUPSORT | MDB_INTEGERKEY));
+static_assert(lmdb::key_trait<lmdb::numeric_trait<double>>);
+static_assert(lmdb::value_trait<lmdb::numeric_trait<int8_t>>);
+
 }  // namespace cpp_lmdb_tests
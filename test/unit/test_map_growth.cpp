@@ -0,0 +1,204 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+#include "mocks.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace cpp_lmdb_tests
+{
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+using test_trait
+    = lmdb::unique_key<lmdb::trivial_trait<int>, lmdb::trivial_trait<int>>;
+
+class test_map_growth : public Test {
+protected:
+    using rw_db = lmdb::rw_db<test_trait, StrictMock<mocks::api>>;
+
+    StrictMock<mocks::api> api;
+
+    MDB_env *test_env{reinterpret_cast<MDB_env *>(0x42)};
+    MDB_txn *test_txn{reinterpret_cast<MDB_txn *>(0x84)};
+
+    constexpr static MDB_dbi test_dbi{10};
+    constexpr static size_t test_map_size{size_t{1} << 20};
+
+    static auto make_env_info(size_t const map_size, size_t const last_pgno)
+    {
+        MDB_envinfo info{};
+        info.me_mapsize = map_size;
+        info.me_last_pgno = last_pgno;
+        return info;
+    }
+};
+
+TEST(map_growth_policy, next_map_size)
+{
+    constexpr lmdb::map_growth_policy_t policy{
+        .growth_factor = 4, .max_map_size = 1000};
+
+    static_assert(policy.next_map_size(100) == 400);
+    static_assert(policy.next_map_size(400) == 1000);
+    static_assert(policy.next_map_size(1000) == 1000);
+    static_assert(lmdb::map_growth_policy_t{}.next_map_size(100) == 200);
+}
+
+TEST_F(test_map_growth, write_replayed_after_map_full)
+{
+    rw_db db{api, test_dbi, *test_env, lmdb::map_growth_policy_t{}};
+
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, 0, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_put(test_txn, test_dbi, _, _, 0))
+            .WillOnce(Return(MDB_MAP_FULL));
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+
+        EXPECT_CALL(api, mdb_env_info(test_env, _))
+            .WillOnce(DoAll(
+                SetArgPointee<1>(make_env_info(test_map_size, 0)),
+                Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_env_set_mapsize(test_env, 2 * test_map_size))
+            .WillOnce(Return(MDB_SUCCESS));
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, 0, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_put(test_txn, test_dbi, _, _, 0))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(api, mdb_txn_commit(test_txn))
+            .WillOnce(Return(MDB_SUCCESS));
+    }
+
+    size_t calls{};
+    auto const result = db.write([&calls](rw_db::rw_transaction &txn) {
+        ++calls;
+        return txn.insert(1, 2);
+    });
+
+    ASSERT_TRUE(result);
+    EXPECT_EQ(calls, 2);
+}
+
+TEST_F(test_map_growth, write_map_full_without_policy)
+{
+    rw_db db{api, test_dbi, *test_env};
+
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, 0, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_put(test_txn, test_dbi, _, _, 0))
+            .WillOnce(Return(MDB_MAP_FULL));
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+    }
+
+    auto const result = db.write(
+        [](rw_db::rw_transaction &txn) { return txn.insert(1, 2); });
+
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), lmdb::error_t::map_full);
+}
+
+TEST_F(test_map_growth, write_fails_when_max_map_size_reached)
+{
+    rw_db db{
+        api,
+        test_dbi,
+        *test_env,
+        lmdb::map_growth_policy_t{.max_map_size = test_map_size}};
+
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, 0, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_txn_commit(test_txn))
+            .WillOnce(Return(MDB_MAP_FULL));
+        EXPECT_CALL(api, mdb_env_info(test_env, _))
+            .WillOnce(DoAll(
+                SetArgPointee<1>(make_env_info(test_map_size, 0)),
+                Return(MDB_SUCCESS)));
+    }
+
+    auto const result = db.write(
+        [](rw_db::rw_transaction &) -> std::expected<void, lmdb::error_t> {
+            return {};
+        });
+
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), lmdb::error_t::map_full);
+}
+
+TEST_F(test_map_growth, write_preallocates_headroom)
+{
+    rw_db db{
+        api,
+        test_dbi,
+        *test_env,
+        lmdb::map_growth_policy_t{.min_free_size = test_map_size}};
+
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_env_info(test_env, _))
+            .WillOnce(DoAll(
+                SetArgPointee<1>(make_env_info(test_map_size, 191)),
+                Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_env_stat(test_env, _))
+            .WillOnce(DoAll(
+                SetArgPointee<1>(MDB_stat{4096, 1, 0, 0, 0, 0}),
+                Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_env_set_mapsize(test_env, 2 * test_map_size))
+            .WillOnce(Return(MDB_SUCCESS));
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, 0, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_txn_commit(test_txn))
+            .WillOnce(Return(MDB_SUCCESS));
+    }
+
+    auto const result = db.write(
+        [](rw_db::rw_transaction &) -> std::expected<void, lmdb::error_t> {
+            return {};
+        });
+
+    ASSERT_TRUE(result);
+}
+
+TEST_F(test_map_growth, reader_adopts_resized_map)
+{
+    rw_db db{api, test_dbi, *test_env, lmdb::map_growth_policy_t{}};
+
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+            .WillOnce(Return(MDB_MAP_RESIZED));
+        EXPECT_CALL(api, mdb_env_set_mapsize(test_env, 0))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+    }
+
+    auto const transaction = db.begin_ro_transaction();
+    ASSERT_TRUE(transaction);
+}
+
+TEST_F(test_map_growth, reader_reports_resized_map_without_policy)
+{
+    rw_db db{api, test_dbi, *test_env};
+
+    EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+        .WillOnce(Return(MDB_MAP_RESIZED));
+
+    auto const transaction = db.begin_ro_transaction();
+    ASSERT_FALSE(transaction);
+    EXPECT_EQ(transaction.error(), lmdb::error_t::map_resized);
+}
+
+}  // namespace cpp_lmdb_tests
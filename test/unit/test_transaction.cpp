@@ -117,6 +117,72 @@ TEST_F(test_transaction, trivial_types_transaction_insert)
     EXPECT_EQ(result.error(), lmdb::error_t::bad_txn);
 }
 
+namespace
+{
+struct reserve_value_trait {
+    using value_type = std::array<uint16_t, 2>;
+
+    static auto to_bytes(value_type const &value) -> lmdb::byte_span
+    {
+        return std::as_bytes(std::span{value});
+    }
+
+    static auto from_bytes(lmdb::byte_span const &) -> value_type
+    {
+        return {};
+    }
+
+    static auto serialized_size(value_type const &) -> size_t
+    {
+        return 3;
+    }
+
+    // encodes the low bytes only to tell the two paths apart
+    static auto serialize_into(
+        value_type const &value, std::span<std::byte> const &bytes) -> void
+    {
+        bytes[0] = std::byte{static_cast<uint8_t>(value[0])};
+        bytes[1] = std::byte{static_cast<uint8_t>(value[1])};
+        bytes[2] = std::byte{0xff};
+    }
+};
+}  // namespace
+
+TEST_F(test_transaction, reserve_insert_serializes_into_map)
+{
+    using reserve_trait
+        = lmdb::unique_key<lmdb::trivial_trait<int>, reserve_value_trait>;
+
+    lmdb::transaction<
+        reserve_trait,
+        lmdb::read_only_t::no,
+        StrictMock<mocks::api>>
+        transaction{test_dbi, std::move(txn)};
+
+    std::array<uint8_t, 3> page{};
+
+    {
+        InSequence const seq;
+
+        EXPECT_CALL(
+            api,
+            mdb_put(
+                test_txn,
+                test_dbi,
+                Pointee(MdbValBytesAre{0x78, 0x56, 0x34, 0x12}),
+                Pointee(Field(&MDB_val::mv_size, 3)),
+                MDB_NOOVERWRITE | MDB_RESERVE))
+            .WillOnce(DoAll(
+                SetArgPointee<3>(MDB_val{page.size(), page.data()}),
+                Return(MDB_SUCCESS)));
+
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+    }
+
+    EXPECT_TRUE(transaction.try_insert(0x12345678, {0x1234, 0x5678}));
+    EXPECT_THAT(page, ElementsAre(0x34, 0x78, 0xff));
+}
+
 TEST_F(test_transaction, trivial_types_transaction_try_insert)
 {
     lmdb::
@@ -211,6 +277,46 @@ TEST_F(test_transaction, trivial_types_transaction_get_not_found)
     EXPECT_EQ(result.error(), lmdb::error_t::not_found);
 }
 
+template <typename T>
+concept has_rvalue_get_view_v
+    = requires(T t) { std::move(t).get_view(std::declval<int>()); };
+
+TEST_F(test_transaction, trivial_types_transaction_get_view)
+{
+    std::array<uint8_t, 4> test_value{0x30, 0x0, 0x0, 0x20};
+
+    lmdb::
+        transaction<test_trait, lmdb::read_only_t::no, StrictMock<mocks::api>>
+            transaction{test_dbi, std::move(txn)};
+
+    static_assert(!has_rvalue_get_view_v<decltype(transaction)>);
+
+    {
+        InSequence const seq;
+
+        EXPECT_CALL(
+            api,
+            mdb_get(
+                test_txn,
+                test_dbi,
+                Pointee(MdbValBytesAre{0x78, 0x56, 0x34, 0x12}),
+                _))
+            .WillOnce(DoAll(
+                SetArgPointee<3>(
+                    MDB_val{test_value.size(), test_value.data()}),
+                Return(MDB_SUCCESS)));
+
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+    }
+
+    const auto result = transaction.get_view(0x12345678);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(
+        static_cast<void const *>(result->data()),
+        static_cast<void const *>(test_value.data()));
+    EXPECT_EQ(result->size(), test_value.size());
+}
+
 template <typename T>
 concept env_has_iterate_by_key_v
     = requires(T t) { t.template iterate_by_key(std::declval<int>()); };
@@ -252,6 +358,129 @@ TEST_F(test_transaction, trivial_types_transaction_iterate)
     ASSERT_NE(it, db_view.end());
 }
 
+TEST_F(test_transaction, iterate_reuses_cached_cursor)
+{
+    lmdb::
+        transaction<test_trait, lmdb::read_only_t::no, StrictMock<mocks::api>>
+            transaction{test_dbi, std::move(txn)};
+
+    auto *cursor{reinterpret_cast<MDB_cursor *>(0x84)};
+
+    {
+        InSequence const seq;
+
+        EXPECT_CALL(api, mdb_cursor_open(test_txn, test_dbi, _))
+            .WillOnce(DoAll(SetArgPointee<2>(cursor), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_cursor_get(cursor, _, _, MDB_FIRST))
+            .Times(2)
+            .WillRepeatedly(Return(MDB_NOTFOUND));
+        EXPECT_CALL(api, mdb_cursor_close(cursor));
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        auto const result = transaction.iterate();
+        ASSERT_TRUE(result);
+        EXPECT_EQ(result->begin(), result->end());
+    }
+}
+
+TEST_F(test_transaction, iterate_range_stops_at_upper_bound)
+{
+    lmdb::
+        transaction<test_trait, lmdb::read_only_t::no, StrictMock<mocks::api>>
+            transaction{test_dbi, std::move(txn)};
+
+    auto *cursor{reinterpret_cast<MDB_cursor *>(0x84)};
+    std::array<uint8_t, 4> current_key{0x02, 0x0, 0x0, 0x0};
+
+    {
+        InSequence const seq;
+
+        EXPECT_CALL(api, mdb_cursor_open(test_txn, test_dbi, _))
+            .WillOnce(DoAll(SetArgPointee<2>(cursor), Return(MDB_SUCCESS)));
+        EXPECT_CALL(
+            api,
+            mdb_cursor_get(
+                cursor,
+                Pointee(MdbValBytesAre{0x01, 0x0, 0x0, 0x0}),
+                _,
+                MDB_SET_RANGE))
+            .WillOnce(DoAll(
+                SetArgPointee<1>(
+                    MDB_val{current_key.size(), current_key.data()}),
+                Return(MDB_SUCCESS)));
+        EXPECT_CALL(
+            api,
+            mdb_cmp(
+                test_txn,
+                test_dbi,
+                Pointee(MdbValBytesAre{0x02, 0x0, 0x0, 0x0}),
+                Pointee(MdbValBytesAre{0x03, 0x0, 0x0, 0x0})))
+            .WillOnce(Return(-1));
+        EXPECT_CALL(api, mdb_cursor_get(cursor, _, _, MDB_NEXT))
+            .WillOnce(DoAll(
+                SetArgPointee<1>(
+                    MDB_val{current_key.size(), current_key.data()}),
+                Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_cmp(test_txn, test_dbi, _, _))
+            .WillOnce(Return(0));
+        EXPECT_CALL(api, mdb_cursor_close(cursor));
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+    }
+
+    auto const result = transaction.iterate_range(1, 3);
+    ASSERT_TRUE(result);
+
+    auto it = result->begin();
+    ASSERT_NE(it, result->end());
+    EXPECT_EQ((*it).key(), 2);
+    ++it;
+    EXPECT_EQ(it, result->end());
+}
+
+TEST_F(test_transaction, nested_transaction_merged_and_discarded)
+{
+    lmdb::
+        transaction<test_trait, lmdb::read_only_t::no, StrictMock<mocks::api>>
+            transaction{test_dbi, std::move(txn)};
+
+    auto *test_env{reinterpret_cast<MDB_env *>(0x21)};
+    auto *nested_txn{reinterpret_cast<MDB_txn *>(0x168)};
+
+    {
+        InSequence const seq;
+
+        EXPECT_CALL(api, mdb_txn_env(test_txn)).WillOnce(Return(test_env));
+        EXPECT_CALL(api, mdb_txn_begin(test_env, test_txn, 0, _))
+            .WillOnce(
+                DoAll(SetArgPointee<3>(nested_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_put(nested_txn, test_dbi, _, _, 0))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(api, mdb_txn_commit(nested_txn))
+            .WillOnce(Return(MDB_SUCCESS));
+
+        EXPECT_CALL(api, mdb_txn_env(test_txn)).WillOnce(Return(test_env));
+        EXPECT_CALL(api, mdb_txn_begin(test_env, test_txn, 0, _))
+            .WillOnce(
+                DoAll(SetArgPointee<3>(nested_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_txn_abort(nested_txn));
+
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+    }
+
+    {
+        auto nested = transaction.begin_nested();
+        ASSERT_TRUE(nested);
+        EXPECT_TRUE(nested->insert(1, 2));
+        EXPECT_TRUE(transaction.merge_nested(std::move(*nested)));
+    }
+    {
+        auto const nested = transaction.begin_nested();
+        ASSERT_TRUE(nested);
+    }
+}
+
 using test_trait_dup
     = lmdb::duplicate_key<lmdb::trivial_trait<int>, lmdb::trivial_trait<int>>;
 
@@ -279,7 +508,7 @@ TEST_F(test_transaction, trivial_types_dup_iterate_by_key)
                 cursor,
                 Pointee(MdbValBytesAre{0x78, 0x56, 0x34, 0x12}),
                 _,
-                MDB_FIRST_DUP))
+                MDB_SET_KEY))
             .WillOnce(DoAll(
                 SetArgPointee<2>(
                     MDB_val{test_value.size(), test_value.data()}),
@@ -301,4 +530,65 @@ TEST_F(test_transaction, trivial_types_dup_iterate_by_key)
     EXPECT_EQ(db_item.value(), 0x20000030);
 }
 
+TEST_F(test_transaction, trivial_types_dup_delete_duplicate)
+{
+    lmdb::transaction<
+        test_trait_dup,
+        lmdb::read_only_t::no,
+        StrictMock<mocks::api>>
+        transaction{test_dbi, std::move(txn)};
+
+    {
+        InSequence const seq;
+
+        EXPECT_CALL(
+            api,
+            mdb_del(
+                test_txn,
+                test_dbi,
+                Pointee(MdbValBytesAre{0x78, 0x56, 0x34, 0x12}),
+                Pointee(MdbValBytesAre{0x30, 0x0, 0x0, 0x20})))
+            .WillOnce(Return(MDB_SUCCESS))
+            .WillOnce(Return(MDB_NOTFOUND));
+
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+    }
+
+    EXPECT_TRUE(transaction.delete_duplicate(0x12345678, 0x20000030));
+    auto const result = transaction.delete_duplicate(0x12345678, 0x20000030);
+    ASSERT_FALSE(result);
+    EXPECT_EQ(result.error(), lmdb::error_t::not_found);
+}
+
+TEST_F(test_transaction, size_reads_db_stats)
+{
+    lmdb::
+        transaction<test_trait, lmdb::read_only_t::yes, StrictMock<mocks::api>>
+            transaction{test_dbi, std::move(txn)};
+
+    {
+        InSequence const seq;
+
+        EXPECT_CALL(api, mdb_stat(test_txn, test_dbi, _))
+            .WillOnce([](MDB_txn *, MDB_dbi, MDB_stat *stat) {
+                *stat = MDB_stat{
+                    .ms_psize = 4096,
+                    .ms_depth = 2,
+                    .ms_branch_pages = 1,
+                    .ms_leaf_pages = 12,
+                    .ms_overflow_pages = 3,
+                    .ms_entries = 1000};
+                return MDB_SUCCESS;
+            })
+            .WillOnce(Return(EINVAL));
+
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+    }
+
+    EXPECT_EQ(transaction.size().value(), 1000);
+    auto const result = transaction.stats();
+    ASSERT_FALSE(result);
+    EXPECT_EQ(std::to_underlying(result.error()), EINVAL);
+}
+
 }  // namespace cpp_lmdb_tests
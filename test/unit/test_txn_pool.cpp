@@ -0,0 +1,161 @@
+#include "cpp_lmdb/cpp_lmdb.hpp"
+#include "mocks.hpp"
+
+// gtest
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace cpp_lmdb_tests
+{
+using namespace ::testing;  // NOLINT(google-build-using-namespace)
+
+using test_trait
+    = lmdb::unique_key<lmdb::trivial_trait<int>, lmdb::trivial_trait<int>>;
+
+class test_txn_pool : public Test {
+protected:
+    using ro_db = lmdb::ro_db<test_trait, StrictMock<mocks::api>>;
+    using ro_txn_pool = lmdb::ro_txn_pool<StrictMock<mocks::api>>;
+
+    StrictMock<mocks::api> api;
+
+    MDB_env *test_env{reinterpret_cast<MDB_env *>(0x42)};
+    MDB_txn *test_txn{reinterpret_cast<MDB_txn *>(0x84)};
+    MDB_txn *other_txn{reinterpret_cast<MDB_txn *>(0x168)};
+
+    constexpr static MDB_dbi test_dbi{10};
+};
+
+TEST_F(test_txn_pool, released_transaction_reset_and_renewed)
+{
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_txn_reset(test_txn));
+        EXPECT_CALL(api, mdb_txn_renew(test_txn))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(api, mdb_txn_reset(test_txn));
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+    }
+
+    ro_txn_pool pool{api, *test_env, 1};
+    ro_db const db{api, test_dbi, *test_env};
+
+    {
+        auto const transaction = db.begin_ro_transaction(pool);
+        ASSERT_TRUE(transaction);
+    }
+    {
+        auto const transaction = db.begin_ro_transaction(pool);
+        ASSERT_TRUE(transaction);
+    }
+
+    auto const stats = pool.stats();
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 1);
+}
+
+TEST_F(test_txn_pool, transaction_over_capacity_aborted)
+{
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+            .WillOnce(
+                DoAll(SetArgPointee<3>(other_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_txn_reset(other_txn));
+        EXPECT_CALL(api, mdb_txn_reset(test_txn));
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+        EXPECT_CALL(api, mdb_txn_abort(other_txn));
+    }
+
+    ro_txn_pool pool{api, *test_env, 1};
+    ro_db const db{api, test_dbi, *test_env};
+
+    {
+        auto const first = db.begin_ro_transaction(pool);
+        auto const second = db.begin_ro_transaction(pool);
+        ASSERT_TRUE(first);
+        ASSERT_TRUE(second);
+    }
+
+    EXPECT_EQ(pool.stats().misses, 2);
+}
+
+TEST_F(test_txn_pool, failed_renew_falls_back_to_new_transaction)
+{
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_txn_reset(test_txn));
+        EXPECT_CALL(api, mdb_txn_renew(test_txn))
+            .WillOnce(Return(MDB_BAD_RSLOT));
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+            .WillOnce(Return(MDB_READERS_FULL));
+    }
+
+    ro_txn_pool pool{api, *test_env, 1};
+    ro_db const db{api, test_dbi, *test_env};
+
+    {
+        auto const transaction = db.begin_ro_transaction(pool);
+        ASSERT_TRUE(transaction);
+    }
+
+    auto const transaction = db.begin_ro_transaction(pool);
+    ASSERT_FALSE(transaction);
+    EXPECT_EQ(transaction.error(), lmdb::error_t::readers_full);
+
+    auto const stats = pool.stats();
+    EXPECT_EQ(stats.hits, 0);
+    EXPECT_EQ(stats.misses, 2);
+}
+
+TEST_F(test_txn_pool, cursor_renewed_with_pooled_transaction)
+{
+    auto *cursor{reinterpret_cast<MDB_cursor *>(0x21)};
+
+    {
+        InSequence seq;
+
+        EXPECT_CALL(api, mdb_txn_begin(test_env, nullptr, MDB_RDONLY, _))
+            .WillOnce(DoAll(SetArgPointee<3>(test_txn), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_cursor_open(test_txn, test_dbi, _))
+            .WillOnce(DoAll(SetArgPointee<2>(cursor), Return(MDB_SUCCESS)));
+        EXPECT_CALL(api, mdb_cursor_get(cursor, _, _, MDB_FIRST))
+            .WillOnce(Return(MDB_NOTFOUND));
+        EXPECT_CALL(api, mdb_txn_reset(test_txn));
+
+        EXPECT_CALL(api, mdb_txn_renew(test_txn))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(api, mdb_cursor_renew(test_txn, cursor))
+            .WillOnce(Return(MDB_SUCCESS));
+        EXPECT_CALL(api, mdb_cursor_get(cursor, _, _, MDB_FIRST))
+            .WillOnce(Return(MDB_NOTFOUND));
+        EXPECT_CALL(api, mdb_txn_reset(test_txn));
+
+        EXPECT_CALL(api, mdb_txn_abort(test_txn));
+        EXPECT_CALL(api, mdb_cursor_close(cursor));
+    }
+
+    ro_txn_pool pool{api, *test_env, 1};
+    ro_db const db{api, test_dbi, *test_env};
+
+    for (int i = 0; i < 2; ++i) {
+        auto const transaction = db.begin_ro_transaction(pool);
+        ASSERT_TRUE(transaction);
+
+        auto const view = transaction->iterate();
+        ASSERT_TRUE(view);
+        EXPECT_EQ(view->begin(), view->end());
+    }
+}
+
+}  // namespace cpp_lmdb_tests